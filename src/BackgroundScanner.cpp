@@ -44,6 +44,8 @@
 
 #include "ofUtils.h"
 
+#include <algorithm>
+
 #if defined(__APPLE__)
 # pragma clang diagnostic push
 # pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -92,12 +94,19 @@
 #endif // defined(__APPLE__)
 
 BackgroundScanner::BackgroundScanner(ServiceViewerApp & owner,
-                                     const float        minScanInterval) :
-    inherited(), _owner(owner), _scanActive(false), _scanInterval(minScanInterval),
-    _scanComplete(false), _scanEnabled(false)
+                                     const float        minScanInterval,
+                                     const float        maxScanInterval,
+                                     const float        connectionScanInterval) :
+    inherited(), _owner(owner), _connectionScanInterval(connectionScanInterval),
+    _maxScanInterval(maxScanInterval), _minScanInterval(minScanInterval),
+    _scanInterval(minScanInterval), _scanEnabled(false), _scanRequested(false),
+    _stopRequested(false)
 {
     ODL_ENTER(); //####
-    _lastScanTime = ofGetElapsedTimef();
+    ODL_P1("owner = ", &owner); //####
+    ODL_D3("minScanInterval = ", minScanInterval, "maxScanInterval = ", maxScanInterval, //####
+           "connectionScanInterval = ", connectionScanInterval); //####
+    _lastScanTime = _lastConnectionScanTime = ofGetElapsedTimef();
     ODL_EXIT_P(this); //####
 } // BackgroundScanner::BackgroundScanner
 
@@ -115,75 +124,131 @@ void
 BackgroundScanner::enableScan(void)
 {
     ODL_OBJENTER(); //####
-    for (bool locked = lock(); ! locked; )
-    {
-        yield();
-    }
-    _scanComplete = false;
+    mutex.lock();
     _scanEnabled = true;
-    unlock();
+    _stateChanged.signal();
+    mutex.unlock();
     ODL_OBJEXIT(); //####
 } // BackgroundScanner::enableScan
 
+float
+BackgroundScanner::getScanInterval(void)
+{
+    ODL_OBJENTER(); //####
+    float result;
+    
+    mutex.lock();
+    result = _scanInterval;
+    mutex.unlock();
+    ODL_OBJEXIT_D(result); //####
+    return result;
+} // BackgroundScanner::getScanInterval
+
+void
+BackgroundScanner::requestImmediateScan(void)
+{
+    ODL_OBJENTER(); //####
+    mutex.lock();
+    _scanRequested = true;
+    _scanInterval = _minScanInterval;
+    _stateChanged.signal();
+    mutex.unlock();
+    ODL_OBJEXIT(); //####
+} // BackgroundScanner::requestImmediateScan
+
+void
+BackgroundScanner::shutDown(void)
+{
+    ODL_OBJENTER(); //####
+    mutex.lock();
+    _stopRequested = true;
+    _stateChanged.signal();
+    mutex.unlock();
+    if (isThreadRunning())
+    {
+        waitForThread(true);
+    }
+    ODL_OBJEXIT(); //####
+} // BackgroundScanner::shutDown
+
 void
 BackgroundScanner::threadedFunction(void)
 {
     ODL_OBJENTER(); //####
     // start
-    while (isThreadRunning())
+    mutex.lock();
+    while (isThreadRunning() && (! _stopRequested))
     {
-        if (lock())
+        if (_scanEnabled)
         {
-            _scanActive = _scanEnabled;
-            _scanEnabled = false;
-            unlock();
-            if (_scanActive)
+            float now = ofGetElapsedTimef();
+            float sleepTime = (_scanRequested ? 0 : _scanInterval - (now - _lastScanTime));
+            float connectionSleepTime = _connectionScanInterval - (now - _lastConnectionScanTime);
+            
+            if ((0 < sleepTime) && (0 < connectionSleepTime))
+            {
+                // Wait out the rest of the shorter interval, unless we are told to stop.
+                sleepTime = std::min(sleepTime, connectionSleepTime);
+                _stateChanged.tryWait(mutex, static_cast<long> (sleepTime *
+                                                                MILLISECONDS_PER_SECOND) + 1);
+            }
+            else if (0 < sleepTime)
             {
-                float sleepTime = _scanInterval - (ofGetElapsedTimef() - _lastScanTime);
+                // Only the connections are due to be checked, which is much cheaper than a full
+                // scan, as the ports are already known.
+                bool changed;
                 
-                if (0 < sleepTime)
+                mutex.unlock();
+                changed = _owner.gatherConnectionsInBackground();
+                mutex.lock();
+                // The interval is measured from the end of the check, so that a slow check is
+                // not followed immediately by another.
+                _lastConnectionScanTime = ofGetElapsedTimef();
+                // A change in the connections suggests that the network is changing.
+                if (changed)
                 {
-                    sleep(sleepTime * MILLISECONDS_PER_SECOND);
+                    _scanInterval = _minScanInterval;
                 }
-                else
-                {
-                    char numBuff[30];
-                    
+            }
+            else
+            {
+                char numBuff[30];
+                bool changed;
+                
+                _scanRequested = false;
+                mutex.unlock();
 #if MAC_OR_LINUX_
-                    snprintf(numBuff, sizeof(numBuff), "%g", ofGetElapsedTimef() - _lastScanTime);
-                    yarp::os::impl::Logger & theLogger = MplusM::Common::GetLogger();
-                    
-                    theLogger.info(yarp::os::ConstString("actual interval = ") + numBuff +
-                                   yarp::os::ConstString(" seconds"));
+                snprintf(numBuff, sizeof(numBuff), "%g", ofGetElapsedTimef() - _lastScanTime);
+                yarp::os::impl::Logger & theLogger = MplusM::Common::GetLogger();
+                
+                theLogger.info(yarp::os::ConstString("actual interval = ") + numBuff +
+                               yarp::os::ConstString(" seconds"));
 #else // ! MAC_OR_LINUX_
-//                    _snprintf(numBuff, sizeof(numBuff) - 1, "%g",
-//                              ofGetElapsedTimef() - _lastScanTime);
-//                    // Correct for the weird behaviour of _snprintf
-//                    numBuff[sizeof(numBuff) - 1] = '\0';
+//                _snprintf(numBuff, sizeof(numBuff) - 1, "%g", ofGetElapsedTimef() - _lastScanTime);
+//                // Correct for the weird behaviour of _snprintf
+//                numBuff[sizeof(numBuff) - 1] = '\0';
 #endif // ! MAC_OR_LINUX_
+                _lastScanTime = _lastConnectionScanTime = ofGetElapsedTimef();
+                changed = _owner.gatherEntitiesInBackground();
+                mutex.lock();
+                // Scan often while the network is changing, and back off while it is stable.
+                if (changed)
+                {
+                    _scanInterval = _minScanInterval;
                 }
-                _lastScanTime = ofGetElapsedTimef();
-                _owner.gatherEntitiesInBackground();
-                for (bool locked = lock(); ! locked; )
+                else
                 {
-                    sleep(MIDDLE_SLEEP);
-                    yield();
+                    _scanInterval = std::min(_scanInterval * 2, _maxScanInterval);
                 }
-                _scanComplete = true;
-                _scanActive = false;
-                unlock();
-                sleep(SHORT_SLEEP);
-            }
-            else
-            {
-                sleep(SHORT_SLEEP);
             }
         }
         else
         {
-            sleep(SHORT_SLEEP);
+            // Nothing to do until scanning is enabled.
+            _stateChanged.wait(mutex);
         }
     }
+    mutex.unlock();
     // done
     ODL_OBJEXIT(); //####
 } // BackgroundScanner::threadedFunction
@@ -41,6 +41,8 @@
 
 # include "ofThread.h"
 
+# include <Poco/Condition.h>
+
 // Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
 # undef check
 # include <mpm/M+MCommon.h>
@@ -59,33 +61,46 @@
 
 class ServiceViewerApp;
 
-/*! @brief A thread class to handle background port scanning. */
+/*! @brief A thread class to handle background port scanning.
+ 
+ The time between scans adapts to the network: it is reset to the minimum whenever a scan finds
+ that something has changed, and is doubled after each scan that finds no changes, up to the
+ maximum. Between the full scans, the connections between the known ports are checked at a fixed,
+ much shorter, interval. */
 class BackgroundScanner : public ofThread
 {
 public :
     
     /*! @brief The constructor.
      @param owner The application object that manages this thread.
-     @param minScanInterval The minimum number of seconds between scans. */
+     @param minScanInterval The minimum number of seconds between scans.
+     @param maxScanInterval The maximum number of seconds between scans.
+     @param connectionScanInterval The number of seconds between checks of the connections. */
     BackgroundScanner(ServiceViewerApp & owner,
-                      const float        minScanInterval);
+                      const float        minScanInterval,
+                      const float        maxScanInterval,
+                      const float        connectionScanInterval);
     
     /*! @brief The destructor. */
     virtual
     ~BackgroundScanner(void);
     
-    /*! @brief The next scan can be initiated. */
+    /*! @brief Scanning can be started. */
     void
     enableScan(void);
     
-    /*! @brief Returns @c true if the scan data is available and @c false otherwise.
-     @returns @c true if the scan data is available and @c false otherwise. */
-    inline bool
-    scanComplete(void)
-    const
-    {
-        return _scanComplete;
-    } // scanComplete
+    /*! @brief Return the current number of seconds between scans.
+     @returns The current number of seconds between scans. */
+    float
+    getScanInterval(void);
+    
+    /*! @brief Start a scan as soon as possible, and return to the minimum time between scans. */
+    void
+    requestImmediateScan(void);
+    
+    /*! @brief Stop the thread, waking it if it is waiting, and wait for it to finish. */
+    void
+    shutDown(void);
     
 protected :
     
@@ -109,22 +124,36 @@ private :
     /*! @brief The application object that manages the thread. */
     ServiceViewerApp & _owner;
     
+    /*! @brief Signalled when a scan is enabled or the thread is to stop. */
+    Poco::Condition _stateChanged;
+    
     /*! @brief The time when the last scan occurred. */
     float _lastScanTime;
     
-    /*! @brief The minimum number of seconds between scans. */
-    float _scanInterval;
+    /*! @brief The time when the connections were last checked. */
+    float _lastConnectionScanTime;
+    
+    /*! @brief The number of seconds between checks of the connections. */
+    float _connectionScanInterval;
     
-    /*! @brief @c true if the scan is active and @c false otherwise. */
-    bool _scanActive;
+    /*! @brief The maximum number of seconds between scans. */
+    float _maxScanInterval;
     
-    /*! @brief @c true if the scan has been finished and the data is available, @c false
-     otherwise. */
-    bool _scanComplete;
+    /*! @brief The minimum number of seconds between scans. */
+    float _minScanInterval;
+    
+    /*! @brief The current number of seconds between scans. */
+    float _scanInterval;
     
     /*! @brief @c true if the scan can be started and @c false otherwise. */
     bool _scanEnabled;
     
+    /*! @brief @c true if a scan is to be started without waiting and @c false otherwise. */
+    bool _scanRequested;
+    
+    /*! @brief @c true if the thread is to stop and @c false otherwise. */
+    bool _stopRequested;
+    
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
 #  pragma clang diagnostic ignored "-Wunused-private-field"
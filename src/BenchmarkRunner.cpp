@@ -0,0 +1,434 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       BenchmarkRunner.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for timing the stages of scanning and display.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "BenchmarkRunner.h"
+#include "ReplayScanSource.h"
+#include "ScanStatistics.h"
+#include "ServiceViewerApp.h"
+#include "Utilities.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofMath.h"
+#include "ofUtils.h"
+
+#include <Poco/AtomicCounter.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for timing the stages of scanning and display. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The names of the stages, in the same order as the Stage values. */
+static const char * kStageNames[] =
+{
+    "scan",
+    "build",
+    "layout",
+    "draw"
+};
+
+/*! @brief The percentiles that are reported for each stage. */
+static const int kPercentiles[] =
+{
+    50,
+    90,
+    99
+};
+
+/*! @brief The number of percentiles that are reported for each stage. */
+static const size_t kPercentileCount = (sizeof(kPercentiles) / sizeof(*kPercentiles));
+
+/*! @brief The seed for the random placement of the entities, so that each run of a case places
+ the entities in the same way. */
+static const int kRandomSeed = 12345;
+
+#if defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
+/*! @brief @c true if the memory allocations are being counted and @c false otherwise. */
+static const bool kCountingAllocations = true;
+
+/*! @brief The number of memory allocations made so far. */
+static Poco::AtomicCounter lAllocationCount;
+#else // ! defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
+/*! @brief @c true if the memory allocations are being counted and @c false otherwise. */
+static const bool kCountingAllocations = false;
+#endif // ! defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Write the minimum, maximum, mean and percentiles of a set of measurements as the fields
+ of a JSON object.
+ @param output Where the fields are to be written.
+ @param values The measurements.
+ @param suffix The suffix for the names of the fields, which gives the units of the
+ measurements. */
+static void
+writeSummary(std::ostream &                  output,
+             std::vector<unsigned long long> values,
+             const char *                    suffix)
+{
+    ODL_ENTER(); //####
+    ODL_P2("output = ", &output, "values = ", &values); //####
+    ODL_S1("suffix = ", suffix); //####
+    unsigned long long total = 0;
+    
+    std::sort(values.begin(), values.end());
+    for (size_t ii = 0, mm = values.size(); mm > ii; ++ii)
+    {
+        total += values[ii];
+    }
+    if (values.empty())
+    {
+        values.push_back(0);
+    }
+    output << "\"min" << suffix << "\":" << values.front() << ",\"max" << suffix << "\":" <<
+                values.back() << ",\"mean" << suffix << "\":" << (total / values.size());
+    // The percentiles are by nearest rank.
+    for (size_t ii = 0; kPercentileCount > ii; ++ii)
+    {
+        size_t rank = ((kPercentiles[ii] * values.size()) + 99) / 100;
+        
+        output << ",\"p" << kPercentiles[ii] << suffix << "\":" <<
+                    values[(0 < rank) ? (rank - 1) : 0];
+    }
+    ODL_EXIT(); //####
+} // writeSummary
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+unsigned long long
+BenchmarkRunner::GetAllocationCount(void)
+{
+#if defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
+    return static_cast<unsigned long long> (lAllocationCount.value());
+#else // ! defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
+    return 0;
+#endif // ! defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
+} // BenchmarkRunner::GetAllocationCount
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+BenchmarkRunner::BenchmarkRunner(const int iterations) :
+    _cases(), _iterations(iterations)
+{
+    ODL_ENTER(); //####
+    ODL_L1("iterations = ", iterations); //####
+    ODL_EXIT_P(this); //####
+} // BenchmarkRunner::BenchmarkRunner
+
+BenchmarkRunner::~BenchmarkRunner(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // BenchmarkRunner::~BenchmarkRunner
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+BenchmarkRunner::addCase(const string &                          name,
+                         const SyntheticScanSource::Parameters & parameters)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("name = ", name); //####
+    ODL_P1("parameters = ", &parameters); //####
+    Case aCase;
+    
+    aCase._name = name;
+    aCase._parameters = parameters;
+    _cases.push_back(aCase);
+    ODL_OBJEXIT(); //####
+} // BenchmarkRunner::addCase
+
+void
+BenchmarkRunner::addRecordedCase(const string & name,
+                                 const string & filePath)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("name = ", name, "filePath = ", filePath); //####
+    Case                              aCase;
+    SyntheticScanSource::Parameters & parameters = aCase._parameters;
+    
+    aCase._name = name;
+    aCase._recordingPath = filePath;
+    // The shape of a recorded network is not known ahead of time.
+    parameters._serviceCount = parameters._portsPerService = parameters._connectionCount = 0;
+    parameters._hungServiceCount = parameters._standaloneCount = 0;
+    parameters._latency = 0;
+    _cases.push_back(aCase);
+    ODL_OBJEXIT(); //####
+} // BenchmarkRunner::addRecordedCase
+
+void
+BenchmarkRunner::addStandardCases(void)
+{
+    ODL_OBJENTER(); //####
+    SyntheticScanSource::Parameters parameters;
+    
+    // Each service has four ports, and one entity in five is a standalone port.
+    parameters._portsPerService = 4;
+    parameters._hungServiceCount = 0;
+    parameters._latency = 0;
+    parameters._serviceCount = 8;
+    parameters._standaloneCount = 2;
+    parameters._connectionCount = 12;
+    addCase("small", parameters);
+    parameters._serviceCount = 80;
+    parameters._standaloneCount = 20;
+    parameters._connectionCount = 120;
+    addCase("medium", parameters);
+    parameters._serviceCount = 4000;
+    parameters._standaloneCount = 1000;
+    parameters._connectionCount = 6000;
+    addCase("large", parameters);
+    ODL_OBJEXIT(); //####
+} // BenchmarkRunner::addStandardCases
+
+void
+BenchmarkRunner::record(const Stage              which,
+                        const unsigned long long startTime,
+                        const unsigned long long startAllocations)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("which = ", which); //####
+    ODL_L2("startTime = ", startTime, "startAllocations = ", startAllocations); //####
+    if ((0 <= which) && (kStageCount > which))
+    {
+        Samples & theSamples = _samples[which];
+        
+        theSamples._times.push_back(ScanStatistics::getTime() - startTime);
+        theSamples._allocations.push_back(GetAllocationCount() - startAllocations);
+    }
+    ODL_OBJEXIT(); //####
+} // BenchmarkRunner::record
+
+bool
+BenchmarkRunner::run(const string & outputPath)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("outputPath = ", outputPath); //####
+    bool               result = true;
+    std::ostringstream output;
+    
+    output << "{\"time\":" << ofGetUnixTime() << ",\"iterations\":" << _iterations <<
+                ",\"countsAllocations\":" << (kCountingAllocations ? "true" : "false") <<
+                ",\"cases\":[";
+    for (CaseList::const_iterator walker(_cases.begin()); result && (_cases.end() != walker);
+         ++walker)
+    {
+        if (_cases.begin() != walker)
+        {
+            output << ",";
+        }
+        result = runCase(*walker, output);
+    }
+    output << "]}";
+    if (result)
+    {
+        if (outputPath.empty())
+        {
+            std::cout << output.str() << std::endl;
+        }
+        else
+        {
+            // The file is replaced in one step, so that a reader never sees a partial file.
+            string        tempPath(outputPath + ".tmp");
+            std::ofstream outFile(tempPath.c_str());
+            
+            if (outFile)
+            {
+                outFile << output.str() << std::endl;
+                outFile.close();
+#if (! MAC_OR_LINUX_)
+                std::remove(outputPath.c_str());
+#endif // ! MAC_OR_LINUX_
+                result = (! outFile.fail()) &&
+                            (0 == std::rename(tempPath.c_str(), outputPath.c_str()));
+            }
+            else
+            {
+                ODL_LOG("! (outFile)"); //####
+                result = false;
+            }
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // BenchmarkRunner::run
+
+bool
+BenchmarkRunner::runCase(const Case &   aCase,
+                         std::ostream & output)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("aCase = ", &aCase, "output = ", &output); //####
+    const SyntheticScanSource::Parameters & parameters = aCase._parameters;
+    bool                                    result;
+    ServiceViewerApp *                      theApp = new ServiceViewerApp;
+    
+    for (int ii = 0; kStageCount > ii; ++ii)
+    {
+        _samples[ii]._times.clear();
+        _samples[ii]._allocations.clear();
+    }
+    ofSeedRandom(kRandomSeed);
+    if (aCase._recordingPath.empty())
+    {
+        theApp->setScanSource(new SyntheticScanSource(parameters));
+    }
+    else
+    {
+        theApp->setScanSource(new ReplayScanSource(aCase._recordingPath));
+    }
+    result = theApp->runBenchmark(*this, _iterations);
+    theApp->exit();
+    delete theApp;
+    if (result)
+    {
+        output << "{\"name\":\"" << EscapeForJson(aCase._name) << "\",";
+        if (aCase._recordingPath.empty())
+        {
+            output << "\"services\":" << parameters._serviceCount << ",\"portsPerService\":" <<
+                        parameters._portsPerService << ",\"connections\":" <<
+                        parameters._connectionCount << ",\"standalonePorts\":" <<
+                        parameters._standaloneCount << ",\"hungServices\":" <<
+                        parameters._hungServiceCount << ",\"latencyMillis\":" <<
+                        parameters._latency;
+        }
+        else
+        {
+            output << "\"recording\":\"" << EscapeForJson(aCase._recordingPath) << "\"";
+        }
+        output << ",\"stages\":{";
+        for (int ii = 0; kStageCount > ii; ++ii)
+        {
+            const Samples & theSamples = _samples[ii];
+            
+            if (0 < ii)
+            {
+                output << ",";
+            }
+            output << "\"" << kStageNames[ii] << "\":{\"count\":" << theSamples._times.size() <<
+                        ",";
+            writeSummary(output, theSamples._times, "Micros");
+            if (kCountingAllocations)
+            {
+                output << ",";
+                writeSummary(output, theSamples._allocations, "Allocations");
+            }
+            output << "}";
+        }
+        output << "}}";
+    }
+    else
+    {
+        ODL_LOG("! (result)"); //####
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // BenchmarkRunner::runCase
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
+
+#if defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
+// The global allocation functions are replaced, so that every allocation, from any thread, is
+// counted.
+void *
+operator new(std::size_t size)
+throw(std::bad_alloc)
+{
+    void * result = malloc(size ? size : 1);
+    
+    if (! result)
+    {
+        throw std::bad_alloc();
+    }
+    ++lAllocationCount;
+    return result;
+} // operator new
+
+void *
+operator new[](std::size_t size)
+throw(std::bad_alloc)
+{
+    return operator new(size);
+} // operator new[]
+
+void
+operator delete(void * pointer)
+throw()
+{
+    free(pointer);
+} // operator delete
+
+void
+operator delete[](void * pointer)
+throw()
+{
+    free(pointer);
+} // operator delete[]
+#endif // defined(SERVICEVIEWER_COUNT_ALLOCATIONS)
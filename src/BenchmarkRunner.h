@@ -0,0 +1,211 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       BenchmarkRunner.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for timing the stages of scanning and display.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__BenchmarkRunner__))
+# define __ServiceViewer__BenchmarkRunner__  /* Header guard */
+
+# include "SyntheticScanSource.h"
+
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for timing the stages of scanning and display. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief Timing the stages of scanning and display.
+ 
+ Each case is a generated or recorded network, which is scanned, built into entities, laid out
+ and drawn a fixed number of times, starting from an empty display each time. The results are
+ written as a single JSON object, with the percentiles of the times of each stage and, if the
+ application was built with SERVICEVIEWER_COUNT_ALLOCATIONS defined, the number of memory
+ allocations made by each stage. The networks and the random placements are the same from one run
+ to the next, so that the results of different builds can be compared. */
+class BenchmarkRunner
+{
+public :
+    
+    /*! @brief The stages that are timed. */
+    enum Stage
+    {
+        /*! @brief Scanning the network. */
+        kStageScan,
+        
+        /*! @brief Building the entities for a scan. */
+        kStageBuild,
+        
+        /*! @brief Positioning all of the entities. */
+        kStageLayout,
+        
+        /*! @brief Drawing a frame. */
+        kStageDraw,
+        
+        /*! @brief The number of stages. */
+        kStageCount
+        
+    }; // Stage
+    
+    /*! @brief The constructor.
+     @param iterations The number of times that each stage is run for each case. */
+    explicit
+    BenchmarkRunner(const int iterations);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~BenchmarkRunner(void);
+    
+    /*! @brief Add a case to be run.
+     @param name The name of the case, for the results.
+     @param parameters The shape of the generated network for the case. */
+    void
+    addCase(const string &                          name,
+            const SyntheticScanSource::Parameters & parameters);
+    
+    /*! @brief Add a case to be run against a recorded network.
+     @param name The name of the case, for the results.
+     @param filePath The path to the recording of the network. */
+    void
+    addRecordedCase(const string & name,
+                    const string & filePath);
+    
+    /*! @brief Add the standard cases, which are networks of about 10, 100 and 5000 entities. */
+    void
+    addStandardCases(void);
+    
+    /*! @brief Record a run of a stage.
+     @param which The stage.
+     @param startTime When the stage began, as returned by ScanStatistics::getTime().
+     @param startAllocations The number of allocations when the stage began, as returned by
+     GetAllocationCount(). */
+    void
+    record(const Stage              which,
+           const unsigned long long startTime,
+           const unsigned long long startAllocations);
+    
+    /*! @brief Run each of the cases and write the results.
+     @param outputPath The file to be replaced with the results; if empty, the results are
+     written to the standard output.
+     @returns @c true if all the cases were run and the results written and @c false
+     otherwise. */
+    bool
+    run(const string & outputPath);
+    
+    /*! @brief Return the number of memory allocations made so far.
+     @returns The number of memory allocations made so far, or zero if allocations are not being
+     counted. */
+    static unsigned long long
+    GetAllocationCount(void);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(BenchmarkRunner);
+    
+    /*! @brief A generated or recorded network to be measured. */
+    struct Case
+    {
+        /*! @brief The name of the case. */
+        string _name;
+        
+        /*! @brief The path to the recording of the network, or empty if the network is
+         generated. */
+        string _recordingPath;
+        
+        /*! @brief The shape of the generated network. */
+        SyntheticScanSource::Parameters _parameters;
+        
+    }; // Case
+    
+    /*! @brief The measurements of one stage. */
+    struct Samples
+    {
+        /*! @brief The time taken by each run, in microseconds. */
+        std::vector<unsigned long long> _times;
+        
+        /*! @brief The number of allocations made by each run. */
+        std::vector<unsigned long long> _allocations;
+        
+    }; // Samples
+    
+    /*! @brief A collection of cases. */
+    typedef std::vector<Case> CaseList;
+    
+    /*! @brief Run a case, adding its results to the output.
+     @param aCase The case to be run.
+     @param output Where the results are to be written.
+     @returns @c true if the case was run and @c false otherwise. */
+    bool
+    runCase(const Case &   aCase,
+            std::ostream & output);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The cases to be run. */
+    CaseList _cases;
+    
+    /*! @brief The measurements of each stage for the case being run. */
+    Samples _samples[kStageCount];
+    
+    /*! @brief The number of times that each stage is run for each case. */
+    int _iterations;
+    
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+    /*! @brief Filler to pad to alignment boundary */
+    char _filler[4];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+    
+}; // BenchmarkRunner
+
+#endif // ! defined(__ServiceViewer__BenchmarkRunner__)
@@ -0,0 +1,451 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ChangeFeed.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for a stream of changes to the network topology.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ChangeFeed.h"
+#include "Utilities.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+
+#include <set>
+#include <sstream>
+
+#if MAC_OR_LINUX_
+# include <cerrno>
+# include <csignal>
+# include <cstring>
+# include <fcntl.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif // MAC_OR_LINUX_
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for a stream of changes to the network topology. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The prefix for a destination that is a local socket. */
+#define SOCKET_PREFIX "unix:"
+
+/*! @brief The length of the prefix for a destination that is a local socket. */
+static const size_t kSocketPrefixLength = sizeof(SOCKET_PREFIX) - 1;
+
+/*! @brief A set of keys. */
+typedef std::set<string> KeySet;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Start a record.
+ @param records The records being written.
+ @param scanNumber The number of the scan being reported.
+ @param now The time of the scan being reported.
+ @param event The kind of change. */
+static void
+startRecord(std::ostream &      records,
+            const unsigned long scanNumber,
+            const unsigned int  now,
+            const char *        event)
+{
+    records << "{\"scan\":" << scanNumber << ",\"time\":" << now << ",\"event\":\"" << event <<
+                "\"";
+} // startRecord
+
+/*! @brief Write the attributes of a port with associates.
+ @param records The records being written.
+ @param entry The port with associates. */
+static void
+writeAssociatesDetails(std::ostream &                          records,
+                       const ScanSnapshot::PortAndAssociates & entry)
+{
+    records << ",\"name\":\"" << EscapeForJson(entry._name) << "\"";
+} // writeAssociatesDetails
+
+/*! @brief Write the records for the connections that have changed.
+ @param records The records being written.
+ @param connections The connections that have changed.
+ @param scanNumber The number of the scan being reported.
+ @param now The time of the scan being reported.
+ @param event The kind of change. */
+static void
+writeConnectionRecords(std::ostream &                       records,
+                       const ScanSnapshot::ConnectionList & connections,
+                       const unsigned long                  scanNumber,
+                       const unsigned int                   now,
+                       const char *                         event)
+{
+    ODL_ENTER(); //####
+    ODL_P2("records = ", &records, "connections = ", &connections); //####
+    ODL_S1("event = ", event); //####
+    for (ScanSnapshot::ConnectionList::const_iterator walker(connections.begin());
+         connections.end() != walker; ++walker)
+    {
+        startRecord(records, scanNumber, now, event);
+        records << ",\"from\":\"" << EscapeForJson(walker->_outPortName) << "\",\"to\":\"" <<
+                    EscapeForJson(walker->_inPortName) << "\",\"mode\":\"" <<
+                    ScanSnapshot::getModeName(walker->_mode) << "\"}\n";
+    }
+    ODL_EXIT(); //####
+} // writeConnectionRecords
+
+/*! @brief Write the records for the entries of one kind that have changed.
+ 
+ An entry whose key has been both removed and added is reported once, as changed, with its new
+ attributes; this is how a port whose direction has been learned is reported.
+ @param records The records being written.
+ @param older The entries in the previous scan.
+ @param newer The entries in the new scan.
+ @param added The keys of the entries that have appeared or changed.
+ @param removed The keys of the entries that have vanished or changed.
+ @param scanNumber The number of the scan being reported.
+ @param now The time of the scan being reported.
+ @param kind The name of the kind of entry.
+ @param writeDetails The function used to write the attributes of an entry. */
+template <typename Collection>
+static void
+writeEntryRecords(std::ostream &                records,
+                  const Collection &            older,
+                  const Collection &            newer,
+                  const ScanSnapshot::KeyList & added,
+                  const ScanSnapshot::KeyList & removed,
+                  const unsigned long           scanNumber,
+                  const unsigned int            now,
+                  const string &                kind,
+                  void                          (* writeDetails)
+                                        (std::ostream &                           records,
+                                         const typename Collection::mapped_type & entry))
+{
+    ODL_ENTER(); //####
+    ODL_P4("records = ", &records, "older = ", &older, "newer = ", &newer, "added = ", //####
+           &added); //####
+    ODL_P1("removed = ", &removed); //####
+    ODL_S1s("kind = ", kind); //####
+    KeySet addedKeys(added.begin(), added.end());
+    KeySet removedKeys(removed.begin(), removed.end());
+    
+    for (ScanSnapshot::KeyList::const_iterator walker(removed.begin()); removed.end() != walker;
+         ++walker)
+    {
+        typename Collection::const_iterator match(older.find(*walker));
+        
+        if ((addedKeys.end() == addedKeys.find(*walker)) && (older.end() != match))
+        {
+            startRecord(records, scanNumber, now, (kind + "Removed").c_str());
+            records << ",\"key\":\"" << EscapeForJson(*walker) << "\"";
+            writeDetails(records, match->second);
+            records << "}\n";
+        }
+    }
+    for (ScanSnapshot::KeyList::const_iterator walker(added.begin()); added.end() != walker;
+         ++walker)
+    {
+        typename Collection::const_iterator match(newer.find(*walker));
+        
+        if (newer.end() != match)
+        {
+            const char * suffix = ((removedKeys.end() == removedKeys.find(*walker)) ? "Added" :
+                                   "Changed");
+            
+            startRecord(records, scanNumber, now, (kind + suffix).c_str());
+            records << ",\"key\":\"" << EscapeForJson(*walker) << "\"";
+            writeDetails(records, match->second);
+            records << "}\n";
+        }
+    }
+    ODL_EXIT(); //####
+} // writeEntryRecords
+
+/*! @brief Write the attributes of a standalone port.
+ @param records The records being written.
+ @param entry The standalone port. */
+static void
+writePortDetails(std::ostream &                         records,
+                 const ScanSnapshot::NameAndDirection & entry)
+{
+    records << ",\"name\":\"" << EscapeForJson(entry._name) << "\",\"direction\":\"" <<
+                ScanSnapshot::getDirectionName(entry._direction) << "\"";
+} // writePortDetails
+
+/*! @brief Write the attributes of a service.
+ @param records The records being written.
+ @param entry The service. */
+static void
+writeServiceDetails(std::ostream &                               records,
+                    const MplusM::Utilities::ServiceDescriptor & entry)
+{
+    records << ",\"name\":\"" << EscapeForJson(entry._serviceName.c_str()) << "\",\"kind\":\"" <<
+                EscapeForJson(entry._kind.c_str()) << "\"";
+} // writeServiceDetails
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ChangeFeed::ChangeFeed(const string & destination) :
+    _destination(destination), _previous(), _scanNumber(0),
+#if MAC_OR_LINUX_
+    _descriptor(-1)
+#else // ! MAC_OR_LINUX_
+    _stream(NULL)
+#endif // ! MAC_OR_LINUX_
+{
+    ODL_ENTER(); //####
+    ODL_S1s("destination = ", destination); //####
+#if MAC_OR_LINUX_
+    // A reader going away must not end the application; the failed write is handled instead.
+    signal(SIGPIPE, SIG_IGN);
+#endif // MAC_OR_LINUX_
+    ODL_EXIT_P(this); //####
+} // ChangeFeed::ChangeFeed
+
+ChangeFeed::~ChangeFeed(void)
+{
+    ODL_OBJENTER(); //####
+    closeDestination();
+    ODL_OBJEXIT(); //####
+} // ChangeFeed::~ChangeFeed
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ChangeFeed::closeDestination(void)
+{
+    ODL_OBJENTER(); //####
+#if MAC_OR_LINUX_
+    if (0 <= _descriptor)
+    {
+        close(_descriptor);
+        _descriptor = -1;
+    }
+#else // ! MAC_OR_LINUX_
+    if (_stream)
+    {
+        fclose(_stream);
+        _stream = NULL;
+    }
+#endif // ! MAC_OR_LINUX_
+    // The next reader will need the whole topology.
+    _previous.clear();
+    ODL_OBJEXIT(); //####
+} // ChangeFeed::closeDestination
+
+bool
+ChangeFeed::openDestination(void)
+{
+    ODL_OBJENTER(); //####
+    bool isSocket = (0 == _destination.compare(0, kSocketPrefixLength, SOCKET_PREFIX));
+    bool result;
+    
+#if MAC_OR_LINUX_
+    if (0 > _descriptor)
+    {
+        if (isSocket)
+        {
+            string             socketPath(_destination.substr(kSocketPrefixLength));
+            struct sockaddr_un address;
+            
+            if (sizeof(address.sun_path) > socketPath.length())
+            {
+                int aSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+                
+                if (0 <= aSocket)
+                {
+                    memset(&address, 0, sizeof(address));
+                    address.sun_family = AF_UNIX;
+                    strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+                    if (0 == connect(aSocket, reinterpret_cast<struct sockaddr *> (&address),
+                                     sizeof(address)))
+                    {
+                        // A reader that stops reading must not hold up the scanning.
+                        fcntl(aSocket, F_SETFL, fcntl(aSocket, F_GETFL) | O_NONBLOCK);
+                        _descriptor = aSocket;
+                    }
+                    else
+                    {
+                        ODL_LOG("! (0 == connect(aSocket, ...))"); //####
+                        close(aSocket);
+                    }
+                }
+            }
+        }
+        else
+        {
+            // The destination is opened and written without blocking, so that a named pipe
+            // without a reader, or with a reader that stops reading, doesn't hold up the scanning.
+            int aDescriptor = open(_destination.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_NONBLOCK,
+                                   0644);
+            
+            if (0 <= aDescriptor)
+            {
+                _descriptor = aDescriptor;
+            }
+        }
+    }
+    result = (0 <= _descriptor);
+#else // ! MAC_OR_LINUX_
+    if (isSocket)
+    {
+        ODL_LOG("(isSocket)"); //####
+    }
+    else if (! _stream)
+    {
+        _stream = fopen(_destination.c_str(), "ab");
+    }
+    result = (NULL != _stream);
+#endif // ! MAC_OR_LINUX_
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChangeFeed::openDestination
+
+void
+ChangeFeed::report(const ScanSnapshot & newer)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("newer = ", &newer); //####
+    ++_scanNumber;
+    if (openDestination())
+    {
+        ScanSnapshot::Delta delta;
+        
+        newer.computeDelta(_previous, delta);
+        if (delta.isEmpty())
+        {
+            ODL_LOG("(delta.isEmpty())"); //####
+        }
+        else
+        {
+            std::ostringstream records;
+            unsigned int       now = ofGetUnixTime();
+            
+            // Removals are written first, so that a reader never sees two entries for one key.
+            writeConnectionRecords(records, delta._removedConnections, _scanNumber, now,
+                                   "connectionRemoved");
+            writeEntryRecords(records, _previous.getServices(), newer.getServices(),
+                              delta._addedServices, delta._removedServices, _scanNumber, now,
+                              "service", writeServiceDetails);
+            writeEntryRecords(records, _previous.getAssociates(), newer.getAssociates(),
+                              delta._addedAssociates, delta._removedAssociates, _scanNumber, now,
+                              "adapter", writeAssociatesDetails);
+            writeEntryRecords(records, _previous.getStandalonePorts(), newer.getStandalonePorts(),
+                              delta._addedPorts, delta._removedPorts, _scanNumber, now, "port",
+                              writePortDetails);
+            writeConnectionRecords(records, delta._addedConnections, _scanNumber, now,
+                                   "connectionAdded");
+            if (writeRecords(records.str()))
+            {
+                _previous.assign(newer);
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ChangeFeed::report
+
+bool
+ChangeFeed::writeRecords(const string & records)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("records = ", records); //####
+    bool result = true;
+    bool stalled = false;
+    
+#if MAC_OR_LINUX_
+    for (size_t written = 0, toWrite = records.length(); result && (toWrite > written); )
+    {
+        ssize_t count = write(_descriptor, records.data() + written, toWrite - written);
+        
+        if (0 < count)
+        {
+            written += static_cast<size_t> (count);
+        }
+        else if ((0 > count) && (EINTR == errno))
+        {
+            ODL_LOG("((0 > count) && (EINTR == errno))"); //####
+        }
+        else if ((0 > count) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)) && (0 == written))
+        {
+            // The reader is not keeping up, so the records are dropped; the changes are included
+            // in the next report, since the previous scan is only replaced once it is written.
+            ODL_LOG("((0 > count) && ((EAGAIN == errno) || (EWOULDBLOCK == errno)) && " //####
+                    "(0 == written))"); //####
+            stalled = true;
+            result = false;
+        }
+        else
+        {
+            // A partial set of records cannot be completed later, so the reader will have to
+            // start over with the whole topology.
+            result = false;
+        }
+    }
+#else // ! MAC_OR_LINUX_
+    result = ((records.length() == fwrite(records.data(), 1, records.length(), _stream)) &&
+              (0 == fflush(_stream)));
+#endif // ! MAC_OR_LINUX_
+    if ((! result) && (! stalled))
+    {
+        // The reader has gone away; the destination will be reopened for the next scan.
+        closeDestination();
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ChangeFeed::writeRecords
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,138 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ChangeFeed.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for a stream of changes to the network topology.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ChangeFeed__))
+# define __ServiceViewer__ChangeFeed__  /* Header guard */
+
+# include "ScanSnapshot.h"
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MCommon.h>
+
+# if (! MAC_OR_LINUX_)
+#  include <cstdio>
+# endif // ! MAC_OR_LINUX_
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for a stream of changes to the network topology. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief A stream of changes to the network topology.
+ 
+ Each scan is compared with the previous one and the differences are written as JSON objects, one
+ per line, so that a reader can follow the topology without scanning the network itself. The
+ destination is either a file or named pipe, which is appended to, or a local socket, given as
+ 'unix:' followed by the path of a listening socket. Whenever the destination is (re)opened, the
+ whole topology is written as additions, so that a new reader starts from a complete picture. The
+ destination is never waited on; if the reader falls behind, the changes are held back and written
+ together with those of a later scan. */
+class ChangeFeed
+{
+public :
+    
+    /*! @brief The constructor.
+     @param destination Where the changes are to be written. */
+    explicit
+    ChangeFeed(const string & destination);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ChangeFeed(void);
+    
+    /*! @brief Write the differences between the previously reported scan and a new scan.
+     @param newer The new scan. */
+    void
+    report(const ScanSnapshot & newer);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(ChangeFeed);
+    
+    /*! @brief Close the destination, if it is open. */
+    void
+    closeDestination(void);
+    
+    /*! @brief Open the destination, if it is not already open.
+     @returns @c true if the destination is open and @c false otherwise. */
+    bool
+    openDestination(void);
+    
+    /*! @brief Write a block of records to the destination, closing it if the write fails for any
+     reason other than the reader falling behind.
+     @param records The records to be written.
+     @returns @c true if the records were written and @c false otherwise. */
+    bool
+    writeRecords(const string & records);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief Where the changes are to be written. */
+    string _destination;
+    
+    /*! @brief The most recently reported scan. */
+    ScanSnapshot _previous;
+    
+    /*! @brief The number of scans that have been reported. */
+    unsigned long _scanNumber;
+    
+# if MAC_OR_LINUX_
+    /*! @brief The file descriptor for the destination, or -1 if it is not open. */
+    int _descriptor;
+# else // ! MAC_OR_LINUX_
+    /*! @brief The stream for the destination, or @c NULL if it is not open. */
+    FILE * _stream;
+# endif // ! MAC_OR_LINUX_
+    
+}; // ChangeFeed
+
+#endif // ! defined(__ServiceViewer__ChangeFeed__)
@@ -0,0 +1,385 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ConnectionRenderer.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for the batched drawing of connections.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ConnectionRenderer.h"
+#include "ServiceEntity.h"
+#include "ServiceViewerApp.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofGraphics.h"
+
+#include <set>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for the batched drawing of connections. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief A pair of connected entities, with the lower address first. */
+typedef std::pair<ServiceEntity *, ServiceEntity *> EntityPair;
+
+/*! @brief The set of pairs of entities that have been connected. */
+typedef std::set<EntityPair> EntityPairSet;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ConnectionRenderer::ConnectionRenderer(void) :
+    _indices(), _viewBounds(), _detailed(true), _needsRefill(true)
+{
+    ODL_ENTER(); //####
+    for (int ii = 0; kLineGroupCount > ii; ++ii)
+    {
+        _visibleCount[ii] = 0;
+    }
+    ODL_EXIT_P(this); //####
+} // ConnectionRenderer::ConnectionRenderer
+
+ConnectionRenderer::~ConnectionRenderer(void)
+{
+    ODL_OBJENTER(); //####
+    for (int ii = 0; kLineGroupCount > ii; ++ii)
+    {
+        _buffers[ii].clear();
+    }
+    ODL_OBJEXIT(); //####
+} // ConnectionRenderer::~ConnectionRenderer
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ConnectionRenderer::addRun(const LineGroup group,
+                           const size_t    firstVertex)
+{
+    ODL_OBJENTER(); //####
+    ODL_L2("group = ", static_cast<int> (group), "firstVertex = ", firstVertex); //####
+    const std::vector<ofVec3f> & vertices = _vertices[group];
+    
+    if (vertices.size() > firstVertex)
+    {
+        LineRun aRun;
+        
+        aRun._bounds.set(vertices[firstVertex].x, vertices[firstVertex].y, 0, 0);
+        for (size_t ii = firstVertex + 1, mm = vertices.size(); mm > ii; ++ii)
+        {
+            aRun._bounds.growToInclude(vertices[ii]);
+        }
+        aRun._first = static_cast<ofIndexType> (firstVertex);
+        aRun._count = static_cast<ofIndexType> (vertices.size() - firstVertex);
+        _runs[group].push_back(aRun);
+    }
+    ODL_OBJEXIT(); //####
+} // ConnectionRenderer::addRun
+
+void
+ConnectionRenderer::addSegment(const LineGroup      group,
+                               const ofPoint &      fromPoint,
+                               const ofPoint &      toPoint,
+                               const ofFloatColor & colour)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("group = ", static_cast<int> (group)); //####
+    ODL_P3("fromPoint = ", &fromPoint, "toPoint = ", &toPoint, "colour = ", &colour); //####
+    _vertices[group].push_back(fromPoint);
+    _vertices[group].push_back(toPoint);
+    _colours[group].push_back(colour);
+    _colours[group].push_back(colour);
+    ODL_OBJEXIT(); //####
+} // ConnectionRenderer::addSegment
+
+void
+ConnectionRenderer::cull(const ofRectangle & viewBounds)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("viewBounds = ", &viewBounds); //####
+    for (int ii = 0; kLineGroupCount > ii; ++ii)
+    {
+        const std::vector<LineRun> & runs = _runs[ii];
+        
+        _indices.clear();
+        for (std::vector<LineRun>::const_iterator it(runs.begin()); runs.end() != it; ++it)
+        {
+            if (viewBounds.intersects(it->_bounds))
+            {
+                for (ofIndexType jj = it->_first, nn = it->_first + it->_count; nn > jj; ++jj)
+                {
+                    _indices.push_back(jj);
+                }
+            }
+        }
+        _visibleCount[ii] = static_cast<int> (_indices.size());
+        if (! _indices.empty())
+        {
+            _buffers[ii].setIndexData(&_indices[0], _visibleCount[ii], GL_DYNAMIC_DRAW);
+        }
+    }
+    _viewBounds = viewBounds;
+    ODL_OBJEXIT(); //####
+} // ConnectionRenderer::cull
+
+void
+ConnectionRenderer::draw(const std::list<ServiceEntity *> & entities,
+                         const ofRectangle &                viewBounds,
+                         const bool                         detailed)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("entities = ", &entities, "viewBounds = ", &viewBounds); //####
+    ODL_B1("detailed = ", detailed); //####
+    if (_needsRefill || (detailed != _detailed))
+    {
+        refill(entities, detailed);
+        _detailed = detailed;
+        _needsRefill = false;
+        cull(viewBounds);
+    }
+    else if (viewBounds != _viewBounds)
+    {
+        cull(viewBounds);
+    }
+    for (int ii = 0; kLineGroupCount > ii; ++ii)
+    {
+        if (0 < _visibleCount[ii])
+        {
+            switch (ii)
+            {
+                case kLineGroupService :
+                    ofSetLineWidth(ServiceViewerApp::getServiceConnectionWidth());
+                    break;
+                
+                case kLineGroupInputOutput :
+                    ofSetLineWidth(ServiceViewerApp::getInputOutputConnectionWidth());
+                    break;
+                
+                case kLineGroupNormal :
+                case kLineGroupOverview :
+                    ofSetLineWidth(ServiceViewerApp::getNormalConnectionWidth());
+                    break;
+                
+                default :
+                    ofSetLineWidth(1);
+                    break;
+                
+            }
+            _buffers[ii].drawElements(GL_LINES, _visibleCount[ii]);
+        }
+    }
+    ofSetLineWidth(1);
+    ODL_OBJEXIT(); //####
+} // ConnectionRenderer::draw
+
+void
+ConnectionRenderer::refill(const std::list<ServiceEntity *> & entities,
+                           const bool                         detailed)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("entities = ", &entities); //####
+    ODL_B1("detailed = ", detailed); //####
+    EntityPairSet connectedPairs;
+    
+    for (int ii = 0; kLineGroupCount > ii; ++ii)
+    {
+        _vertices[ii].clear();
+        _colours[ii].clear();
+        _runs[ii].clear();
+    }
+    for (std::list<ServiceEntity *>::const_iterator it(entities.begin()); entities.end() != it;
+         ++it)
+    {
+        ServiceEntity * anEntity = *it;
+        
+        if (anEntity)
+        {
+            for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+            {
+                PortEntry * anEntry = anEntity->getPort(ii);
+                
+                if (anEntry)
+                {
+                    const PortEntry::Connections & connex = anEntry->getOutputConnections();
+                    
+                    for (size_t jj = 0, nn = connex.size(); nn > jj; ++jj)
+                    {
+                        PortEntry *  otherEntry = connex[jj]._otherPort;
+                        LineGroup    group;
+                        ofFloatColor colour;
+                        
+                        if (otherEntry->isService())
+                        {
+                            group = kLineGroupService;
+                        }
+                        else if (otherEntry->isInputOutput())
+                        {
+                            group = kLineGroupInputOutput;
+                        }
+                        else
+                        {
+                            group = kLineGroupNormal;
+                        }
+                        switch (connex[jj]._connectionMode)
+                        {
+                            case MplusM::Common::kChannelModeTCP :
+                                colour = ServiceViewerApp::getTcpConnectionColor();
+                                break;
+                            
+                            case MplusM::Common::kChannelModeUDP :
+                                colour = ServiceViewerApp::getUdpConnectionColor();
+                                break;
+                            
+                            default :
+                                colour = ServiceViewerApp::getOtherConnectionColor();
+                                break;
+                            
+                        }
+                        if (detailed)
+                        {
+                            PortEntry::ConnectionGeometry & geometry =
+                                                                anEntry->getOutputGeometry(jj);
+                            const vector<ofPoint> &         curvePoints =
+                                                                geometry._curve.getVertices();
+                            size_t                          groupStart =
+                                                                _vertices[group].size();
+                            size_t                          arrowheadStart =
+                                                        _vertices[kLineGroupArrowhead].size();
+                            ofPoint                         first;
+                            ofPoint                         second;
+                            
+                            for (size_t kk = 1, ll = curvePoints.size(); ll > kk; ++kk)
+                            {
+                                addSegment(group, curvePoints[kk - 1], curvePoints[kk], colour);
+                            }
+                            if (PortEntry::calculateSourceAnchor(geometry._anchorHere,
+                                                                 geometry._fromHere, first,
+                                                                 second))
+                            {
+                                addSegment(kLineGroupArrowhead, geometry._fromHere, first,
+                                           colour);
+                                addSegment(kLineGroupArrowhead, geometry._fromHere, second,
+                                           colour);
+                            }
+                            if (PortEntry::calculateTargetAnchor(geometry._anchorThere,
+                                                                 geometry._toThere, first,
+                                                                 second))
+                            {
+                                addSegment(kLineGroupArrowhead, geometry._toThere, first,
+                                           colour);
+                                addSegment(kLineGroupArrowhead, geometry._toThere, second,
+                                           colour);
+                            }
+                            addRun(group, groupStart);
+                            addRun(kLineGroupArrowhead, arrowheadStart);
+                        }
+                        else
+                        {
+                            // Only the first connection between a pair of entities is drawn,
+                            // without the curve or the arrowheads being calculated.
+                            PortPanel *     otherPanel = otherEntry->getParent();
+                            ServiceEntity * otherEntity = (otherPanel ?
+                                                           &otherPanel->getContainer() : NULL);
+                            
+                            if (otherEntity && (otherEntity != anEntity))
+                            {
+                                EntityPair aPair;
+                                
+                                if (anEntity < otherEntity)
+                                {
+                                    aPair = EntityPair(anEntity, otherEntity);
+                                }
+                                else
+                                {
+                                    aPair = EntityPair(otherEntity, anEntity);
+                                }
+                                if (connectedPairs.insert(aPair).second)
+                                {
+                                    size_t overviewStart = _vertices[kLineGroupOverview].size();
+                                    
+                                    addSegment(kLineGroupOverview,
+                                               anEntity->getShape().getCenter(),
+                                               otherEntity->getShape().getCenter(), colour);
+                                    addRun(kLineGroupOverview, overviewStart);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (int ii = 0; kLineGroupCount > ii; ++ii)
+    {
+        if (_vertices[ii].empty())
+        {
+            _buffers[ii].clear();
+        }
+        else
+        {
+            _buffers[ii].setVertexData(&_vertices[ii][0], static_cast<int> (_vertices[ii].size()),
+                                       GL_DYNAMIC_DRAW);
+            _buffers[ii].setColorData(&_colours[ii][0], static_cast<int> (_colours[ii].size()),
+                                      GL_DYNAMIC_DRAW);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ConnectionRenderer::refill
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,227 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ConnectionRenderer.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for the batched drawing of connections.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ConnectionRenderer__))
+# define __ServiceViewer__ConnectionRenderer__  /* Header guard */
+
+# include "PortEntry.h"
+
+# include "ofVbo.h"
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MCommon.h>
+
+# include <list>
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for the batched drawing of connections. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+class ServiceEntity;
+
+/*! @brief The batched drawing of connections.
+ 
+ The connection curves and arrowheads are held in one vertex buffer for each line width, with the
+ colours as vertex attributes, so that they can be drawn with one call per line width. The buffers
+ are only refilled after the connections or the entities have changed, or when the level of detail
+ changes. Each connection is recorded as a run of vertices with a bounding box, and only the runs
+ that are within the visible area are added to the index buffers, which are rebuilt when the view
+ moves; connections that are off the display are not sent to be drawn at all. When the details
+ are not being displayed, each pair of connected entities is joined by a single straight line, so
+ that the cost of a frame depends on the number of entities rather than on the number of ports. */
+class ConnectionRenderer
+{
+public :
+    
+    /*! @brief The constructor. */
+    ConnectionRenderer(void);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ConnectionRenderer(void);
+    
+    /*! @brief Draw the connections between a set of entities.
+     @param entities The entities whose output connections are to be drawn.
+     @param viewBounds The visible area of the display.
+     @param detailed @c true if each connection is to be drawn between its ports and @c false if
+     the connections are to be drawn between the entities. */
+    void
+    draw(const std::list<ServiceEntity *> & entities,
+         const ofRectangle &                viewBounds,
+         const bool                         detailed = true);
+    
+    /*! @brief Indicate that the connections or the entities have changed. */
+    inline void
+    invalidate(void)
+    {
+        _needsRefill = true;
+    } // invalidate
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(ConnectionRenderer);
+    
+    /*! @brief The groups of lines, by line width. */
+    enum LineGroup
+    {
+        /*! @brief Connections to service ports. */
+        kLineGroupService,
+        
+        /*! @brief Connections to input / output ports. */
+        kLineGroupInputOutput,
+        
+        /*! @brief Connections to other ports. */
+        kLineGroupNormal,
+        
+        /*! @brief Arrowheads. */
+        kLineGroupArrowhead,
+        
+        /*! @brief Connections between entities. */
+        kLineGroupOverview,
+        
+        /*! @brief The number of groups. */
+        kLineGroupCount
+        
+    }; // LineGroup
+    
+    /*! @brief A set of consecutive line segments in a group that are drawn or skipped together. */
+    struct LineRun
+    {
+        /*! @brief The bounding box of the line segments. */
+        ofRectangle _bounds;
+        
+        /*! @brief The index of the first vertex of the line segments. */
+        ofIndexType _first;
+        
+        /*! @brief The number of vertices of the line segments. */
+        ofIndexType _count;
+        
+    }; // LineRun
+    
+    /*! @brief Record the line segments that have been added to a group since a given vertex as a
+     run.
+     @param group The group that was added to.
+     @param firstVertex The number of vertices in the group before the line segments were added. */
+    void
+    addRun(const LineGroup group,
+           const size_t    firstVertex);
+    
+    /*! @brief Add a line segment to a group.
+     @param group The group to add to.
+     @param fromPoint The beginning of the line segment.
+     @param toPoint The end of the line segment.
+     @param colour The colour of the line segment. */
+    void
+    addSegment(const LineGroup      group,
+               const ofPoint &      fromPoint,
+               const ofPoint &      toPoint,
+               const ofFloatColor & colour);
+    
+    /*! @brief Select the runs that are within the visible area for drawing.
+     @param viewBounds The visible area of the display. */
+    void
+    cull(const ofRectangle & viewBounds);
+    
+    /*! @brief Fill the vertex buffers with the connections between a set of entities.
+     @param entities The entities whose output connections are to be drawn.
+     @param detailed @c true if each connection is to be drawn between its ports and @c false if
+     the connections are to be drawn between the entities. */
+    void
+    refill(const std::list<ServiceEntity *> & entities,
+           const bool                         detailed);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The line segment end points for each group. */
+    std::vector<ofVec3f> _vertices[kLineGroupCount];
+    
+    /*! @brief The line segment colours for each group. */
+    std::vector<ofFloatColor> _colours[kLineGroupCount];
+    
+    /*! @brief The runs of line segments for each group. */
+    std::vector<LineRun> _runs[kLineGroupCount];
+    
+    /*! @brief The indices of the visible vertices, while an index buffer is being built. */
+    std::vector<ofIndexType> _indices;
+    
+    /*! @brief The vertex buffers, one for each group. */
+    ofVbo _buffers[kLineGroupCount];
+    
+    /*! @brief The visible area of the display when the runs were last selected. */
+    ofRectangle _viewBounds;
+    
+    /*! @brief The number of visible vertices of each group. */
+    int _visibleCount[kLineGroupCount];
+    
+    /*! @brief @c true if the vertex buffers hold the connections between ports and @c false if it
+     holds the connections between entities. */
+    bool _detailed;
+    
+    /*! @brief @c true if the vertex buffer is to be refilled before drawing and @c false
+     otherwise. */
+    bool _needsRefill;
+    
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+    /*! @brief Filler to pad to alignment boundary */
+    char _filler[6];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+    
+}; // ConnectionRenderer
+
+#endif // ! defined(__ServiceViewer__ConnectionRenderer__)
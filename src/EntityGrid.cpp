@@ -0,0 +1,271 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       EntityGrid.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for a spatial index of the displayed entities.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "EntityGrid.h"
+#include "ServiceEntity.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for a spatial index of the displayed entities. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The width and height of a cell; roughly the size of a typical entity, so that most
+ entities overlap only a few cells. */
+static const float kCellSize = 256;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the cell coordinate for a display coordinate.
+ @param position The display coordinate.
+ @returns The cell coordinate. */
+static int
+cellForPosition(const float position)
+{
+    return static_cast<int> (floor(position / kCellSize));
+} // cellForPosition
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+EntityGrid::EntityGrid(void) :
+    _cells(), _entries(), _nextStackOrder(0)
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // EntityGrid::EntityGrid
+
+EntityGrid::~EntityGrid(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // EntityGrid::~EntityGrid
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+EntityGrid::addToCells(ServiceEntity *     anEntity,
+                       const ofRectangle & bounds)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("anEntity = ", anEntity, "bounds = ", &bounds); //####
+    int firstColumn = cellForPosition(bounds.getMinX());
+    int lastColumn = cellForPosition(bounds.getMaxX());
+    int firstRow = cellForPosition(bounds.getMinY());
+    int lastRow = cellForPosition(bounds.getMaxY());
+    
+    for (int column = firstColumn; lastColumn >= column; ++column)
+    {
+        for (int row = firstRow; lastRow >= row; ++row)
+        {
+            _cells[CellKey(column, row)].push_back(anEntity);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntityGrid::addToCells
+
+void
+EntityGrid::clear(void)
+{
+    ODL_OBJENTER(); //####
+    _cells.clear();
+    _entries.clear();
+    _nextStackOrder = 0;
+    ODL_OBJEXIT(); //####
+} // EntityGrid::clear
+
+ServiceEntity *
+EntityGrid::findEntity(const float xx,
+                       const float yy)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_D2("xx = ", xx, "yy = ", yy); //####
+    ServiceEntity *         result = NULL;
+    CellMap::const_iterator match(_cells.find(CellKey(cellForPosition(xx),
+                                                      cellForPosition(yy))));
+    
+    if (_cells.end() != match)
+    {
+        const CellContents & contents = match->second;
+        unsigned long        highest = 0;
+        
+        for (CellContents::const_iterator walker(contents.begin()); contents.end() != walker;
+             ++walker)
+        {
+            EntryMap::const_iterator anEntry(_entries.find(*walker));
+            
+            if ((_entries.end() != anEntry) && anEntry->second._bounds.inside(xx, yy) &&
+                ((! result) || (highest < anEntry->second._stackOrder)))
+            {
+                result = *walker;
+                highest = anEntry->second._stackOrder;
+            }
+        }
+    }
+    ODL_OBJEXIT_P(result); //####
+    return result;
+} // EntityGrid::findEntity
+
+void
+EntityGrid::raise(ServiceEntity * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    if (anEntity)
+    {
+        EntryMap::iterator match(_entries.find(anEntity));
+        
+        if (_entries.end() == match)
+        {
+            update(anEntity);
+        }
+        else
+        {
+            match->second._stackOrder = ++_nextStackOrder;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntityGrid::raise
+
+void
+EntityGrid::remove(ServiceEntity * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    EntryMap::iterator match(_entries.find(anEntity));
+    
+    if (_entries.end() != match)
+    {
+        removeFromCells(anEntity, match->second._bounds);
+        _entries.erase(match);
+    }
+    ODL_OBJEXIT(); //####
+} // EntityGrid::remove
+
+void
+EntityGrid::removeFromCells(ServiceEntity *     anEntity,
+                            const ofRectangle & bounds)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("anEntity = ", anEntity, "bounds = ", &bounds); //####
+    int firstColumn = cellForPosition(bounds.getMinX());
+    int lastColumn = cellForPosition(bounds.getMaxX());
+    int firstRow = cellForPosition(bounds.getMinY());
+    int lastRow = cellForPosition(bounds.getMaxY());
+    
+    for (int column = firstColumn; lastColumn >= column; ++column)
+    {
+        for (int row = firstRow; lastRow >= row; ++row)
+        {
+            CellMap::iterator match(_cells.find(CellKey(column, row)));
+            
+            if (_cells.end() != match)
+            {
+                CellContents & contents = match->second;
+                
+                contents.erase(std::remove(contents.begin(), contents.end(), anEntity),
+                               contents.end());
+                // Empty cells are dropped, so that the map only holds the occupied area.
+                if (contents.empty())
+                {
+                    _cells.erase(match);
+                }
+            }
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntityGrid::removeFromCells
+
+void
+EntityGrid::update(ServiceEntity * anEntity)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("anEntity = ", anEntity); //####
+    if (anEntity)
+    {
+        ofRectangle        bounds(anEntity->getShape());
+        EntryMap::iterator match(_entries.find(anEntity));
+        
+        if (_entries.end() == match)
+        {
+            GridEntry newEntry;
+            
+            newEntry._bounds = bounds;
+            newEntry._stackOrder = ++_nextStackOrder;
+            _entries.insert(EntryMap::value_type(anEntity, newEntry));
+            addToCells(anEntity, bounds);
+        }
+        else if (match->second._bounds != bounds)
+        {
+            removeFromCells(anEntity, match->second._bounds);
+            match->second._bounds = bounds;
+            addToCells(anEntity, bounds);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // EntityGrid::update
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
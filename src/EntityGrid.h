@@ -0,0 +1,170 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       EntityGrid.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for a spatial index of the displayed entities.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__EntityGrid__))
+# define __ServiceViewer__EntityGrid__  /* Header guard */
+
+# include "ofRectangle.h"
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MCommon.h>
+
+# include <map>
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for a spatial index of the displayed entities. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+class ServiceEntity;
+
+/*! @brief A spatial index of the displayed entities.
+ 
+ The display is divided into square cells and each entity is recorded in every cell that its
+ bounding box overlaps, so that finding the entity under a point only examines the entities that
+ share its cell. The stacking order of the entities is kept as well, so that the entity that is
+ drawn last is the one that is found. */
+class EntityGrid
+{
+public :
+    
+    /*! @brief The constructor. */
+    EntityGrid(void);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~EntityGrid(void);
+    
+    /*! @brief Forget all the entities. */
+    void
+    clear(void);
+    
+    /*! @brief Find the topmost entity that contains a point.
+     @param xx The horizontal position of the point.
+     @param yy The vertical position of the point.
+     @returns @c NULL if no entity contains the point and non-@c NULL if an entity is found. */
+    ServiceEntity *
+    findEntity(const float xx,
+               const float yy)
+    const;
+    
+    /*! @brief Place an entity above all the other entities, adding it if it is not present.
+     @param anEntity The entity to be raised. */
+    void
+    raise(ServiceEntity * anEntity);
+    
+    /*! @brief Forget an entity.
+     @param anEntity The entity to be removed. */
+    void
+    remove(ServiceEntity * anEntity);
+    
+    /*! @brief Record the current bounding box of an entity, adding it if it is not present.
+     @param anEntity The entity to be updated. */
+    void
+    update(ServiceEntity * anEntity);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(EntityGrid);
+    
+    /*! @brief The location of a cell. */
+    typedef std::pair<int, int> CellKey;
+    
+    /*! @brief The entities that overlap a cell. */
+    typedef std::vector<ServiceEntity *> CellContents;
+    
+    /*! @brief A mapping from cell locations to the entities that overlap the cells. */
+    typedef std::map<CellKey, CellContents> CellMap;
+    
+    /*! @brief The recorded state of an entity. */
+    struct GridEntry
+    {
+        /*! @brief The bounding box of the entity. */
+        ofRectangle _bounds;
+        
+        /*! @brief The position of the entity in the stacking order; larger is higher. */
+        unsigned long _stackOrder;
+        
+    }; // GridEntry
+    
+    /*! @brief A mapping from entities to their recorded state. */
+    typedef std::map<ServiceEntity *, GridEntry> EntryMap;
+    
+    /*! @brief Add an entity to the cells that its bounding box overlaps.
+     @param anEntity The entity to be added.
+     @param bounds The bounding box of the entity. */
+    void
+    addToCells(ServiceEntity *     anEntity,
+               const ofRectangle & bounds);
+    
+    /*! @brief Remove an entity from the cells that its bounding box overlaps.
+     @param anEntity The entity to be removed.
+     @param bounds The bounding box of the entity. */
+    void
+    removeFromCells(ServiceEntity *     anEntity,
+                    const ofRectangle & bounds);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The entities that overlap each occupied cell. */
+    CellMap _cells;
+    
+    /*! @brief The recorded state of each entity. */
+    EntryMap _entries;
+    
+    /*! @brief The stacking position to be given to the next raised entity. */
+    unsigned long _nextStackOrder;
+    
+}; // EntityGrid
+
+#endif // ! defined(__ServiceViewer__EntityGrid__)
@@ -0,0 +1,564 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       LayoutWorker.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for a thread class to calculate entity layouts.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "LayoutWorker.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofMath.h"
+
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/energybased/FMMMLayout.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for a thread class to calculate entity layouts. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief A grid cell. */
+typedef std::pair<int, int> CellKey;
+
+/*! @brief A mapping from grid cells to the entities within them. */
+typedef std::map<CellKey, std::vector<size_t> > CellMap;
+
+/*! @brief The width and height of a grid cell, used to find nearby entities. */
+static const float kGridCellSize = 400;
+
+/*! @brief The preferred distance between connected entities, beyond their own sizes. */
+static const float kIdealEdgeLength = 150;
+
+/*! @brief The shortest preferred distance between connected entities. */
+static const float kMinEdgeLength = 40;
+
+/*! @brief The number of steps in an incremental layout. */
+static const int kLocalIterations = 50;
+
+/*! @brief The largest fraction of unpinned entities for which an incremental layout is done. */
+static const float kMaxIncrementalFraction = 0.5;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the grid cell containing a point.
+ @param aPoint The point of interest.
+ @returns The grid cell containing the point. */
+static CellKey
+cellForPoint(const ofPoint & aPoint)
+{
+    ODL_ENTER(); //####
+    ODL_P1("aPoint = ", &aPoint); //####
+    CellKey result(static_cast<int> (floor(aPoint.x / kGridCellSize)),
+                   static_cast<int> (floor(aPoint.y / kGridCellSize)));
+    
+    ODL_L2("result.first = ", result.first, "result.second = ", result.second); //####
+    ODL_EXIT(); //####
+    return result;
+} // cellForPoint
+
+/*! @brief Return the preferred length of an edge between two entities with a number of connections
+ between them, relative to the length of an edge with a single connection.
+ @param weight The number of connections between the entities.
+ @returns The relative preferred length of the edge. */
+static float
+edgeFactorForWeight(const int weight)
+{
+    ODL_ENTER(); //####
+    ODL_L1("weight = ", weight); //####
+    float result = 1;
+    
+    if (1 < weight)
+    {
+        result = std::max(1 / sqrt(static_cast<float> (weight)),
+                          kMinEdgeLength / kIdealEdgeLength);
+    }
+    ODL_EXIT_D(result); //####
+    return result;
+} // edgeFactorForWeight
+
+/*! @brief Return the preferred distance between two entities with a number of connections between
+ them.
+ @param weight The number of connections between the entities.
+ @returns The preferred distance between the entities. */
+static float
+edgeLengthForWeight(const int weight)
+{
+    ODL_ENTER(); //####
+    ODL_L1("weight = ", weight); //####
+    float result = kIdealEdgeLength * edgeFactorForWeight(weight);
+    
+    ODL_EXIT_D(result); //####
+    return result;
+} // edgeLengthForWeight
+
+/*! @brief Return the push that one entity receives from another entity.
+ @param here The centre of the entity being pushed.
+ @param there The centre of the other entity.
+ @param separation The combined half-sizes of the two entities.
+ @returns The push that the entity receives. */
+static ofPoint
+repulsion(const ofPoint & here,
+          const ofPoint & there,
+          const float     separation)
+{
+    ODL_ENTER(); //####
+    ODL_P2("here = ", &here, "there = ", &there); //####
+    ODL_D1("separation = ", separation); //####
+    ofPoint delta = here - there;
+    float   distance = delta.length();
+    float   ideal = kIdealEdgeLength + separation;
+    ofPoint result;
+    
+    if (distance < (2 * ideal))
+    {
+        if (1 > distance)
+        {
+            // Coincident entities are pushed apart in an arbitrary direction.
+            delta = ofPoint(ofRandom(- 1, 1), ofRandom(- 1, 1));
+            distance = 1;
+        }
+        result = delta * ((ideal * ideal) / (distance * distance));
+    }
+    ODL_EXIT(); //####
+    return result;
+} // repulsion
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+LayoutWorker::LayoutWorker(ScanStatistics & statistics) :
+    inherited(), _statistics(statistics), _pendingRequest(), _results(), _requestPending(false),
+    _resultsReady(false), _stopRequested(false)
+{
+    ODL_ENTER(); //####
+    ODL_P1("statistics = ", &statistics); //####
+    ODL_EXIT_P(this); //####
+} // LayoutWorker::LayoutWorker
+
+LayoutWorker::~LayoutWorker(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // LayoutWorker::~LayoutWorker
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+LayoutWorker::calculateFullLayout(const LayoutRequest & request,
+                                  PositionMap &         positions)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("request = ", &request, "positions = ", &positions); //####
+    ogdf::Graph             gg;
+    ogdf::GraphAttributes   ga(gg);
+    ogdf::node              phantomNode = gg.newNode();
+    ogdf::EdgeArray<double> edgeLengths(gg, 1.0);
+    ofPoint                 anchorShift;
+    size_t                  numPinned = 0;
+    std::vector<ogdf::node> nodes;
+    std::vector<bool>       wasConnected(request._nodes.size(), false);
+    
+    ga.directed(true);
+    // If nodes are not connected, OGDF will pile them all at the origin; by adding a 'phantom' node
+    // that is connected to every other node, we force OGDF to spread the nodes out.
+    ga.width(phantomNode) = 1;
+    ga.height(phantomNode) = 1;
+    ga.x(phantomNode) = request._viewOrigin.x + ofRandom(request._fullWidth);
+    ga.y(phantomNode) = request._viewOrigin.y + ofRandom(request._fullHeight);
+    nodes.reserve(request._nodes.size());
+    for (std::vector<LayoutNode>::const_iterator it(request._nodes.begin());
+         request._nodes.end() != it; ++it)
+    {
+        ogdf::node aNode = gg.newNode();
+        
+        ga.width(aNode) = it->_width;
+        ga.height(aNode) = it->_height;
+        ga.x(aNode) = it->_x;
+        ga.y(aNode) = it->_y;
+        nodes.push_back(aNode);
+    }
+    // Set up the edges (connections); entities with more connections between them are pulled
+    // closer together. Note that the layout treats the edge lengths as multiples of its own unit
+    // edge length, so they are given as factors rather than as distances.
+    for (std::vector<LayoutEdge>::const_iterator it(request._edges.begin());
+         request._edges.end() != it; ++it)
+    {
+        if ((nodes.size() > it->_from) && (nodes.size() > it->_to))
+        {
+            ogdf::edge ee = gg.newEdge(nodes[it->_from], nodes[it->_to]);
+            
+            edgeLengths[ee] = edgeFactorForWeight(it->_weight);
+            wasConnected[it->_from] = wasConnected[it->_to] = true;
+        }
+    }
+    for (size_t ii = 0, mm = nodes.size(); mm > ii; ++ii)
+    {
+        if (! wasConnected[ii])
+        {
+            /*ogdf::edge phantomNodeToThis =*/ gg.newEdge(phantomNode, nodes[ii]);
+        }
+    }
+    // Apply an energy-based layout
+    ogdf::FMMMLayout fmmm;
+    
+    fmmm.useHighLevelOptions(true);
+    fmmm.newInitialPlacement(false); //true);
+    fmmm.qualityVersusSpeed(ogdf::FMMMLayout::qvsGorgeousAndEfficient);
+    fmmm.allowedPositions(ogdf::FMMMLayout::apAll);
+    fmmm.initialPlacementMult(ogdf::FMMMLayout::ipmAdvanced);
+    fmmm.initialPlacementForces(ogdf::FMMMLayout::ipfKeepPositions);
+    fmmm.repForcesStrength(2.0);
+    fmmm.call(ga, edgeLengths);
+    // The layout moves every node, but the pinned entities stay where they are; they act as
+    // anchors, with the other entities shifted by the average movement of the pinned entities so
+    // that they keep their places relative to them.
+    for (size_t ii = 0, mm = nodes.size(); mm > ii; ++ii)
+    {
+        const LayoutNode & aNode = request._nodes[ii];
+        
+        if (aNode._pinned)
+        {
+            anchorShift += ofPoint(aNode._x - ga.x(nodes[ii]), aNode._y - ga.y(nodes[ii]));
+            ++numPinned;
+        }
+    }
+    if (0 < numPinned)
+    {
+        anchorShift /= static_cast<float> (numPinned);
+    }
+    positions.clear();
+    for (size_t ii = 0, mm = nodes.size(); mm > ii; ++ii)
+    {
+        const LayoutNode & aNode = request._nodes[ii];
+        
+        if (! aNode._pinned)
+        {
+            positions[aNode._key] = ofPoint(ga.x(nodes[ii]), ga.y(nodes[ii])) + anchorShift;
+        }
+    }
+    gg.clear();
+    ODL_OBJEXIT(); //####
+} // LayoutWorker::calculateFullLayout
+
+
+void
+LayoutWorker::calculateIncrementalLayout(const LayoutRequest & request,
+                                         PositionMap &         positions)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("request = ", &request, "positions = ", &positions); //####
+    size_t                           numNodes = request._nodes.size();
+    std::vector<ofPoint>             centres(numNodes);
+    std::vector<float>               sizes(numNodes);
+    std::vector<size_t>              movable;
+    std::vector<std::vector<size_t> > neighbours(numNodes);
+    std::vector<std::vector<int> >   weights(numNodes);
+    CellMap                          pinnedCells;
+    
+    for (size_t ii = 0; numNodes > ii; ++ii)
+    {
+        const LayoutNode & aNode = request._nodes[ii];
+        
+        centres[ii] = ofPoint(aNode._x + (aNode._width / 2), aNode._y + (aNode._height / 2));
+        sizes[ii] = std::max(aNode._width, aNode._height);
+        if (aNode._pinned)
+        {
+            pinnedCells[cellForPoint(centres[ii])].push_back(ii);
+        }
+        else
+        {
+            movable.push_back(ii);
+        }
+    }
+    for (std::vector<LayoutEdge>::const_iterator it(request._edges.begin());
+         request._edges.end() != it; ++it)
+    {
+        if ((numNodes > it->_from) && (numNodes > it->_to) && (it->_from != it->_to))
+        {
+            if (! request._nodes[it->_from]._pinned)
+            {
+                neighbours[it->_from].push_back(it->_to);
+                weights[it->_from].push_back(it->_weight);
+            }
+            if (! request._nodes[it->_to]._pinned)
+            {
+                neighbours[it->_to].push_back(it->_from);
+                weights[it->_to].push_back(it->_weight);
+            }
+        }
+    }
+    // Start each new entity next to the pinned entities that it is connected to; entities without
+    // pinned neighbours keep their random starting position.
+    for (std::vector<size_t>::const_iterator it(movable.begin()); movable.end() != it; ++it)
+    {
+        const std::vector<size_t> & nodeNeighbours = neighbours[*it];
+        ofPoint                     sum;
+        int                         count = 0;
+        
+        for (std::vector<size_t>::const_iterator walker(nodeNeighbours.begin());
+             nodeNeighbours.end() != walker; ++walker)
+        {
+            if (request._nodes[*walker]._pinned)
+            {
+                sum += centres[*walker];
+                ++count;
+            }
+        }
+        if (0 < count)
+        {
+            centres[*it] = (sum / count) + ofPoint(ofRandom(- kIdealEdgeLength, kIdealEdgeLength),
+                                                   ofRandom(- kIdealEdgeLength, kIdealEdgeLength));
+        }
+    }
+    // Run a force pass over the new entities only, with the pinned entities as fixed obstacles and
+    // anchors; only the pinned entities in the nearby grid cells are considered.
+    for (int step = 0; kLocalIterations > step; ++step)
+    {
+        float                temperature = kIdealEdgeLength * (kLocalIterations - step) /
+                                            kLocalIterations;
+        std::vector<ofPoint> displacements(movable.size());
+        
+        for (size_t ii = 0, mm = movable.size(); mm > ii; ++ii)
+        {
+            size_t                      thisNode = movable[ii];
+            const ofPoint &             here = centres[thisNode];
+            const std::vector<size_t> & nodeNeighbours = neighbours[thisNode];
+            const std::vector<int> &    nodeWeights = weights[thisNode];
+            CellKey                     hereCell(cellForPoint(here));
+            
+            // Attraction to connected entities, stronger for entities with more connections.
+            for (size_t jj = 0, nn = nodeNeighbours.size(); nn > jj; ++jj)
+            {
+                size_t  otherNode = nodeNeighbours[jj];
+                ofPoint delta = centres[otherNode] - here;
+                float   distance = std::max(delta.length(), 1.0f);
+                float   ideal = edgeLengthForWeight(nodeWeights[jj]) +
+                                ((sizes[thisNode] + sizes[otherNode]) / 2);
+                
+                displacements[ii] += delta * (distance / ideal);
+            }
+            // Repulsion from nearby pinned entities.
+            for (int dx = - 1; 1 >= dx; ++dx)
+            {
+                for (int dy = - 1; 1 >= dy; ++dy)
+                {
+                    CellMap::const_iterator match(pinnedCells.find(CellKey(hereCell.first + dx,
+                                                                           hereCell.second + dy)));
+                    
+                    if (pinnedCells.end() != match)
+                    {
+                        for (std::vector<size_t>::const_iterator walker(match->second.begin());
+                             match->second.end() != walker; ++walker)
+                        {
+                            displacements[ii] += repulsion(here, centres[*walker],
+                                                           (sizes[thisNode] + sizes[*walker]) / 2);
+                        }
+                    }
+                }
+            }
+            // Repulsion from the other new entities.
+            for (size_t jj = 0; mm > jj; ++jj)
+            {
+                if (ii != jj)
+                {
+                    size_t otherNode = movable[jj];
+                    
+                    displacements[ii] += repulsion(here, centres[otherNode],
+                                                   (sizes[thisNode] + sizes[otherNode]) / 2);
+                }
+            }
+        }
+        for (size_t ii = 0, mm = movable.size(); mm > ii; ++ii)
+        {
+            float distance = displacements[ii].length();
+            
+            if (0 < distance)
+            {
+                centres[movable[ii]] += displacements[ii] * (std::min(distance, temperature) /
+                                                             distance);
+            }
+        }
+    }
+    positions.clear();
+    for (std::vector<size_t>::const_iterator it(movable.begin()); movable.end() != it; ++it)
+    {
+        const LayoutNode & aNode = request._nodes[*it];
+        
+        positions[aNode._key] = ofPoint(centres[*it].x - (aNode._width / 2),
+                                        centres[*it].y - (aNode._height / 2));
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutWorker::calculateIncrementalLayout
+
+void
+LayoutWorker::calculateLayout(const LayoutRequest & request,
+                              PositionMap &         positions)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("request = ", &request, "positions = ", &positions); //####
+    size_t numPinned = 0;
+    
+    for (std::vector<LayoutNode>::const_iterator it(request._nodes.begin());
+         request._nodes.end() != it; ++it)
+    {
+        if (it->_pinned)
+        {
+            ++numPinned;
+        }
+    }
+    // The first scan, or a large change, gets a complete layout.
+    if ((0 < numPinned) && ((request._nodes.size() - numPinned) <=
+                            (request._nodes.size() * kMaxIncrementalFraction)))
+    {
+        calculateIncrementalLayout(request, positions);
+    }
+    else
+    {
+        calculateFullLayout(request, positions);
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutWorker::calculateLayout
+
+bool
+LayoutWorker::fetchResults(PositionMap & positions)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("positions = ", &positions); //####
+    bool result;
+    
+    mutex.lock();
+    result = _resultsReady;
+    if (_resultsReady)
+    {
+        positions.swap(_results);
+        _results.clear();
+        _resultsReady = false;
+    }
+    mutex.unlock();
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // LayoutWorker::fetchResults
+
+void
+LayoutWorker::requestLayout(const LayoutRequest & request)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("request = ", &request); //####
+    mutex.lock();
+    _pendingRequest = request;
+    _requestPending = true;
+    _stateChanged.signal();
+    mutex.unlock();
+    ODL_OBJEXIT(); //####
+} // LayoutWorker::requestLayout
+
+void
+LayoutWorker::shutDown(void)
+{
+    ODL_OBJENTER(); //####
+    mutex.lock();
+    _stopRequested = true;
+    _stateChanged.signal();
+    mutex.unlock();
+    if (isThreadRunning())
+    {
+        waitForThread(true);
+    }
+    ODL_OBJEXIT(); //####
+} // LayoutWorker::shutDown
+
+void
+LayoutWorker::threadedFunction(void)
+{
+    ODL_OBJENTER(); //####
+    // start
+    mutex.lock();
+    while (isThreadRunning() && (! _stopRequested))
+    {
+        if (_requestPending)
+        {
+            LayoutRequest      request;
+            PositionMap        positions;
+            unsigned long long startTime = ScanStatistics::getTime();
+            
+            std::swap(request, _pendingRequest);
+            _requestPending = false;
+            mutex.unlock();
+            calculateLayout(request, positions);
+            _statistics.record(ScanStatistics::kMeasurementLayout, startTime);
+            mutex.lock();
+            _results.swap(positions);
+            _resultsReady = true;
+        }
+        else
+        {
+            // Nothing to do until a layout is requested.
+            _stateChanged.wait(mutex);
+        }
+    }
+    mutex.unlock();
+    // done
+    ODL_OBJEXIT(); //####
+} // LayoutWorker::threadedFunction
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,241 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       LayoutWorker.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for a thread class to calculate entity layouts.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__LayoutWorker__))
+# define __ServiceViewer__LayoutWorker__  /* Header guard */
+
+# include "ScanStatistics.h"
+
+# include "ofThread.h"
+# include "ofTypes.h"
+
+# include <Poco/Condition.h>
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MCommon.h>
+
+# include <map>
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for a thread class to calculate entity layouts. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief A thread class to calculate entity layouts.
+ 
+ The layout is calculated from a plain description of the entities and their connections, so that
+ the displayed entities can continue to be drawn and changed while the layout is in progress.
+ 
+ When most of the entities are pinned, only the unpinned entities are placed, next to the entities
+ that they are connected to, so that the cost depends on the number of new entities rather than on
+ the size of the whole graph. Otherwise, the whole graph is laid out with FMMM. */
+class LayoutWorker : public ofThread
+{
+public :
+    
+    /*! @brief An entity to be positioned. */
+    struct LayoutNode
+    {
+        /*! @brief The key of the entity. */
+        string _key;
+        
+        /*! @brief The horizontal position of the entity. */
+        float _x;
+        
+        /*! @brief The vertical position of the entity. */
+        float _y;
+        
+        /*! @brief The width of the entity. */
+        float _width;
+        
+        /*! @brief The height of the entity. */
+        float _height;
+        
+        /*! @brief @c true if the entity is to stay where it is and @c false if it can be moved. */
+        bool _pinned;
+        
+    }; // LayoutNode
+    
+    /*! @brief The connections between two entities. */
+    struct LayoutEdge
+    {
+        /*! @brief The index of the source entity. */
+        size_t _from;
+        
+        /*! @brief The index of the destination entity. */
+        size_t _to;
+        
+        /*! @brief The number of connections between the two entities. */
+        int _weight;
+        
+    }; // LayoutEdge
+    
+    /*! @brief The entities to be positioned and their connections. */
+    struct LayoutRequest
+    {
+        /*! @brief The entities to be positioned. */
+        std::vector<LayoutNode> _nodes;
+        
+        /*! @brief The connections between the entities, with one edge per pair of entities. */
+        std::vector<LayoutEdge> _edges;
+        
+        /*! @brief The top left corner of the visible part of the display. */
+        ofPoint _viewOrigin;
+        
+        /*! @brief The width of the visible part of the display. */
+        float _fullWidth;
+        
+        /*! @brief The height of the visible part of the display. */
+        float _fullHeight;
+        
+    }; // LayoutRequest
+    
+    /*! @brief A mapping from entity keys to positions. */
+    typedef std::map<string, ofPoint> PositionMap;
+    
+    /*! @brief The constructor.
+     @param statistics Where the time taken by each layout is recorded. */
+    explicit
+    LayoutWorker(ScanStatistics & statistics);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~LayoutWorker(void);
+    
+    /*! @brief Retrieve the results of the most recently completed layout.
+     @param positions The new positions of the entities.
+     @returns @c true if a layout was completed since the last call and @c false otherwise. */
+    bool
+    fetchResults(PositionMap & positions);
+    
+    /*! @brief Start a layout calculation, replacing any calculation that has not yet started.
+     @param request The entities to be positioned and their connections. */
+    void
+    requestLayout(const LayoutRequest & request);
+    
+    /*! @brief Stop the thread, waking it if it is waiting, and wait for it to finish. */
+    void
+    shutDown(void);
+    
+protected :
+    
+    /*! @brief The thread run function. */
+    virtual void
+    threadedFunction(void);
+    
+private :
+    
+    COPY_AND_ASSIGNMENT_(LayoutWorker);
+    
+    /*! @brief Calculate the positions of all the entities in a set, keeping the pinned entities
+     where they are.
+     @param request The entities to be positioned and their connections.
+     @param positions The new positions of the entities that are not pinned. */
+    void
+    calculateFullLayout(const LayoutRequest & request,
+                        PositionMap &         positions);
+    
+    /*! @brief Calculate the positions of the unpinned entities in a set, leaving the pinned
+     entities where they are.
+     @param request The entities to be positioned and their connections.
+     @param positions The new positions of the unpinned entities. */
+    void
+    calculateIncrementalLayout(const LayoutRequest & request,
+                               PositionMap &         positions);
+    
+    /*! @brief Calculate the positions of a set of entities.
+     @param request The entities to be positioned and their connections.
+     @param positions The new positions of the entities. */
+    void
+    calculateLayout(const LayoutRequest & request,
+                    PositionMap &         positions);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The class that this class is derived from. */
+    typedef ofThread inherited;
+    
+    /*! @brief Where the time taken by each layout is recorded. */
+    ScanStatistics & _statistics;
+    
+    /*! @brief Signalled when a layout is requested or the thread is to stop. */
+    Poco::Condition _stateChanged;
+    
+    /*! @brief The layout to be calculated next. */
+    LayoutRequest _pendingRequest;
+    
+    /*! @brief The results of the most recently completed layout. */
+    PositionMap _results;
+    
+    /*! @brief @c true if a layout has been requested and not yet started and @c false
+     otherwise. */
+    bool _requestPending;
+    
+    /*! @brief @c true if a layout has been completed and not yet retrieved and @c false
+     otherwise. */
+    bool _resultsReady;
+    
+    /*! @brief @c true if the thread is to stop and @c false otherwise. */
+    bool _stopRequested;
+    
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+    /*! @brief Filler to pad to alignment boundary */
+    char _filler[5];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+    
+}; // LayoutWorker
+
+#endif // ! defined(__ServiceViewer__LayoutWorker__)
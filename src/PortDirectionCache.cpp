@@ -0,0 +1,281 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       PortDirectionCache.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for a persistent cache of port directions.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "PortDirectionCache.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+#include "ofxXmlSettings.h"
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for a persistent cache of port directions. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The tag for the address of a port. */
+#define ADDRESS_TAG "address"
+
+/*! @brief The tag for the direction of a port. */
+#define DIRECTION_TAG "direction"
+
+/*! @brief The tag for the time when a port was last seen. */
+#define LAST_SEEN_TAG "lastSeen"
+
+/*! @brief The tag for the name of a port. */
+#define NAME_TAG "name"
+
+/*! @brief The tag for a port. */
+#define PORT_TAG "port"
+
+/*! @brief The tag for the collection of ports. */
+#define PORTS_TAG "ports"
+
+/*! @brief The maximum time, in seconds, that an entry is kept without the port being seen. */
+static const unsigned int kMaxEntryAge = 24 * 60 * 60;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the key to be used for a port.
+ @param portName The name of the port.
+ @param portAddress The IP address and port number of the port.
+ @returns The key to be used for the port. */
+static string
+makeKey(const string & portName,
+        const string & portAddress)
+{
+    return portName + " " + portAddress;
+} // makeKey
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+PortDirectionCache::PortDirectionCache(void) :
+    _entries()
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // PortDirectionCache::PortDirectionCache
+
+PortDirectionCache::~PortDirectionCache(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // PortDirectionCache::~PortDirectionCache
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+PortDirectionCache::clear(void)
+{
+    ODL_OBJENTER(); //####
+    _lock.lock();
+    _entries.clear();
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // PortDirectionCache::clear
+
+bool
+PortDirectionCache::load(const string & filePath)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("filePath = ", filePath); //####
+    bool           result = false;
+    ofxXmlSettings settings;
+    
+    if (settings.loadFile(filePath))
+    {
+        if (settings.pushTag(PORTS_TAG))
+        {
+            unsigned int now = ofGetUnixTime();
+            
+            _lock.lock();
+            for (int ii = 0, mm = settings.getNumTags(PORT_TAG); mm > ii; ++ii)
+            {
+                CacheEntry anEntry;
+                
+                anEntry._name = settings.getValue(PORT_TAG ":" NAME_TAG, "", ii);
+                anEntry._address = settings.getValue(PORT_TAG ":" ADDRESS_TAG, "", ii);
+                anEntry._direction = static_cast<PortEntry::PortDirection>
+                                        (settings.getValue(PORT_TAG ":" DIRECTION_TAG,
+                                                           PortEntry::kPortDirectionUnknown, ii));
+                anEntry._lastSeen = static_cast<unsigned int>
+                                        (settings.getValue(PORT_TAG ":" LAST_SEEN_TAG, 0, ii));
+                if ((0 < anEntry._name.length()) &&
+                    (PortEntry::kPortDirectionUnknown != anEntry._direction) &&
+                    ((anEntry._lastSeen + kMaxEntryAge) > now))
+                {
+                    _entries[makeKey(anEntry._name, anEntry._address)] = anEntry;
+                }
+            }
+            _lock.unlock();
+            settings.popTag();
+            result = true;
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // PortDirectionCache::load
+
+bool
+PortDirectionCache::lookup(const string &             portName,
+                           const string &             portAddress,
+                           PortEntry::PortDirection & direction)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("portName = ", portName, "portAddress = ", portAddress); //####
+    ODL_P1("direction = ", &direction); //####
+    bool result = false;
+    
+    _lock.lock();
+    EntryMap::iterator match(_entries.find(makeKey(portName, portAddress)));
+    
+    if (_entries.end() != match)
+    {
+        match->second._lastSeen = ofGetUnixTime();
+        direction = match->second._direction;
+        result = true;
+    }
+    _lock.unlock();
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // PortDirectionCache::lookup
+
+void
+PortDirectionCache::remember(const string &                 portName,
+                             const string &                 portAddress,
+                             const PortEntry::PortDirection direction)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("portName = ", portName, "portAddress = ", portAddress); //####
+    ODL_L1("direction = ", direction); //####
+    // A failed check might be due to a transient network problem, so it isn't worth remembering.
+    if (PortEntry::kPortDirectionUnknown != direction)
+    {
+        CacheEntry anEntry;
+        
+        anEntry._name = portName;
+        anEntry._address = portAddress;
+        anEntry._direction = direction;
+        anEntry._lastSeen = ofGetUnixTime();
+        _lock.lock();
+        _entries[makeKey(portName, portAddress)] = anEntry;
+        _lock.unlock();
+    }
+    ODL_OBJEXIT(); //####
+} // PortDirectionCache::remember
+
+void
+PortDirectionCache::removeExpiredEntries(void)
+{
+    ODL_OBJENTER(); //####
+    unsigned int now = ofGetUnixTime();
+    
+    _lock.lock();
+    for (EntryMap::iterator walker(_entries.begin()); _entries.end() != walker; )
+    {
+        if ((walker->second._lastSeen + kMaxEntryAge) > now)
+        {
+            ++walker;
+        }
+        else
+        {
+            _entries.erase(walker++);
+        }
+    }
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // PortDirectionCache::removeExpiredEntries
+
+bool
+PortDirectionCache::save(const string & filePath)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("filePath = ", filePath); //####
+    ofxXmlSettings settings;
+    
+    removeExpiredEntries();
+    settings.addTag(PORTS_TAG);
+    settings.pushTag(PORTS_TAG);
+    _lock.lock();
+    int index = 0;
+    
+    for (EntryMap::const_iterator walker(_entries.begin()); _entries.end() != walker; ++walker)
+    {
+        const CacheEntry & anEntry = walker->second;
+        
+        settings.addTag(PORT_TAG);
+        settings.pushTag(PORT_TAG, index++);
+        settings.addValue(NAME_TAG, anEntry._name);
+        settings.addValue(ADDRESS_TAG, anEntry._address);
+        settings.addValue(DIRECTION_TAG, static_cast<int> (anEntry._direction));
+        settings.addValue(LAST_SEEN_TAG, static_cast<int> (anEntry._lastSeen));
+        settings.popTag();
+    }
+    _lock.unlock();
+    settings.popTag();
+    bool result = settings.saveFile(filePath);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // PortDirectionCache::save
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,155 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       PortDirectionCache.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for a persistent cache of port directions.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__PortDirectionCache__))
+# define __ServiceViewer__PortDirectionCache__  /* Header guard */
+
+# include "PortEntry.h"
+
+# include "ofTypes.h"
+
+# include <map>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for a persistent cache of port directions. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief A persistent cache of port directions.
+ 
+ Determining the direction of a port requires a pair of test connections, so the results are kept
+ across scans and across runs of the application. A port is identified by both its name and its
+ network address, so that a new port with a recycled name will be checked again. */
+class PortDirectionCache
+{
+public :
+    
+    /*! @brief The constructor. */
+    PortDirectionCache(void);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~PortDirectionCache(void);
+    
+    /*! @brief Remove all the entries from the cache. */
+    void
+    clear(void);
+    
+    /*! @brief Read the cache from a file, discarding any entries that have expired.
+     @param filePath The path to the file.
+     @returns @c true if the file was read and @c false otherwise. */
+    bool
+    load(const string & filePath);
+    
+    /*! @brief Find the direction of a port.
+     @param portName The name of the port.
+     @param portAddress The IP address and port number of the port.
+     @param direction The direction of the port, if it is known.
+     @returns @c true if the direction of the port is known and @c false otherwise. */
+    bool
+    lookup(const string &             portName,
+           const string &             portAddress,
+           PortEntry::PortDirection & direction);
+    
+    /*! @brief Record the direction of a port.
+     @param portName The name of the port.
+     @param portAddress The IP address and port number of the port.
+     @param direction The direction of the port. */
+    void
+    remember(const string &                 portName,
+             const string &                 portAddress,
+             const PortEntry::PortDirection direction);
+    
+    /*! @brief Remove any entries that have not been seen recently. */
+    void
+    removeExpiredEntries(void);
+    
+    /*! @brief Write the cache to a file.
+     @param filePath The path to the file.
+     @returns @c true if the file was written and @c false otherwise. */
+    bool
+    save(const string & filePath);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(PortDirectionCache);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The information recorded for a port. */
+    struct CacheEntry
+    {
+        /*! @brief The name of the port. */
+        string _name;
+        
+        /*! @brief The IP address and port number of the port. */
+        string _address;
+        
+        /*! @brief The time, in seconds, when the port was last seen. */
+        unsigned int _lastSeen;
+        
+        /*! @brief The direction of the port. */
+        PortEntry::PortDirection _direction;
+        
+    }; // CacheEntry
+    
+    /*! @brief A mapping from port keys to cache entries. */
+    typedef std::map<string, CacheEntry> EntryMap;
+    
+    /*! @brief The known port directions. */
+    EntryMap _entries;
+    
+    /*! @brief Control access to the known port directions. */
+    ofMutex _lock;
+    
+}; // PortDirectionCache
+
+#endif // ! defined(__ServiceViewer__PortDirectionCache__)
@@ -168,6 +168,25 @@ calculateAnchorForPoint(ofPoint &       newCentre,
     return anchor;
 } // calculateAnchorForPoint
 
+/*! @brief Return the number of times that the entity containing a port has been moved.
+ @param aPort The port of interest.
+ @returns The number of times that the entity containing the port has been moved. */
+static unsigned int
+versionForPort(const PortEntry * aPort)
+{
+    ODL_ENTER(); //####
+    ODL_P1("aPort = ", aPort); //####
+    unsigned int result = 0;
+    PortPanel *  aPanel = aPort->getParent();
+    
+    if (aPanel)
+    {
+        result = aPanel->getContainer().getGeometryVersion();
+    }
+    ODL_EXIT_L(result); //####
+    return result;
+} // versionForPort
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -193,6 +212,23 @@ PortEntry::PortEntry(IconlessPanel *     parent,
 PortEntry::~PortEntry(void)
 {
     ODL_OBJENTER(); //####
+    // Make sure that the ports that are connected to this port don't refer to it anymore.
+    for (Connections::const_iterator walker(_inputConnections.begin());
+         _inputConnections.end() != walker; ++walker)
+    {
+        if (walker->_otherPort)
+        {
+            walker->_otherPort->removeOutputConnection(this);
+        }
+    }
+    for (Connections::const_iterator walker(_outputConnections.begin());
+         _outputConnections.end() != walker; ++walker)
+    {
+        if (walker->_otherPort)
+        {
+            walker->_otherPort->removeInputConnection(this);
+        }
+    }
     ODL_OBJEXIT(); //####
 } // PortEntry::~PortEntry
 
@@ -262,6 +298,10 @@ PortEntry::addOutputConnection(PortEntry *                 other,
             
             newConnection._otherPort = other;
             newConnection._connectionMode = mode;
+            newConnection._geometry._anchorHere = newConnection._geometry._anchorThere =
+                                                                                kAnchorUnknown;
+            // Version numbers start at one, so the shape will be calculated when first needed.
+            newConnection._geometry._sourceVersion = newConnection._geometry._targetVersion = 0;
             _outputConnections.push_back(newConnection);
         }
     }
@@ -319,6 +359,88 @@ PortEntry::calculateClosestAnchor(ofPoint &       result,
     return anchor;
 } // PortEntry::calculateClosestAnchor
 
+bool
+PortEntry::calculateSourceAnchor(const AnchorSide anchor,
+                                 const ofPoint &  anchorPos,
+                                 ofPoint &        first,
+                                 ofPoint &        second)
+{
+    ODL_ENTER(); //####
+    ODL_L1("anchor = ", static_cast<int> (anchor)); //####
+    ODL_P3("anchorPos = ", &anchorPos, "first = ", &first, "second = ", &second); //####
+    bool result = (kAnchorUnknown != anchor);
+    
+    switch (anchor)
+    {
+        case kAnchorLeft :
+            first = anchorPos + ofPoint(kArrowSize, -kArrowSize);
+            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
+            break;
+        
+        case kAnchorRight :
+            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
+            second = anchorPos + ofPoint(-kArrowSize, kArrowSize);
+            break;
+        
+        case kAnchorBottomCentre :
+            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
+            second = anchorPos + ofPoint(kArrowSize, -kArrowSize);
+            break;
+        
+        case kAnchorTopCentre :
+            first = anchorPos + ofPoint(-kArrowSize, kArrowSize);
+            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
+            break;
+        
+        default :
+            break;
+        
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // PortEntry::calculateSourceAnchor
+
+bool
+PortEntry::calculateTargetAnchor(const AnchorSide anchor,
+                                 const ofPoint &  anchorPos,
+                                 ofPoint &        first,
+                                 ofPoint &        second)
+{
+    ODL_ENTER(); //####
+    ODL_L1("anchor = ", static_cast<int> (anchor)); //####
+    ODL_P3("anchorPos = ", &anchorPos, "first = ", &first, "second = ", &second); //####
+    bool result = (kAnchorUnknown != anchor);
+    
+    switch (anchor)
+    {
+        case kAnchorLeft :
+            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
+            second = anchorPos + ofPoint(-kArrowSize, kArrowSize);
+            break;
+        
+        case kAnchorRight :
+            first = anchorPos + ofPoint(kArrowSize, -kArrowSize);
+            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
+            break;
+        
+        case kAnchorBottomCentre :
+            first = anchorPos + ofPoint(-kArrowSize, kArrowSize);
+            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
+            break;
+        
+        case kAnchorTopCentre :
+            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
+            second = anchorPos + ofPoint(kArrowSize, -kArrowSize);
+            break;
+        
+        default :
+            break;
+        
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // PortEntry::calculateTargetAnchor
+
 void
 PortEntry::drawDragLine(const float xPos,
                         const float yPos,
@@ -379,33 +501,7 @@ PortEntry::drawSourceAnchor(const AnchorSide anchor,
     ofPoint first;
     ofPoint second;
     
-    switch (anchor)
-    {
-        case kAnchorLeft :
-            first = anchorPos + ofPoint(kArrowSize, -kArrowSize);
-            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
-            break;
-            
-        case kAnchorRight :
-            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
-            second = anchorPos + ofPoint(-kArrowSize, kArrowSize);
-            break;
-            
-        case kAnchorBottomCentre :
-            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
-            second = anchorPos + ofPoint(kArrowSize, -kArrowSize);
-            break;
-            
-        case kAnchorTopCentre :
-            first = anchorPos + ofPoint(-kArrowSize, kArrowSize);
-            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
-            break;
-            
-        default :
-            break;
-            
-    }
-    if (kAnchorUnknown != anchor)
+    if (calculateSourceAnchor(anchor, anchorPos, first, second))
     {
         ofLine(anchorPos, first);
         ofLine(anchorPos, second);
@@ -423,33 +519,7 @@ PortEntry::drawTargetAnchor(const AnchorSide anchor,
     ofPoint first;
     ofPoint second;
     
-    switch (anchor)
-    {
-        case kAnchorLeft :
-            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
-            second = anchorPos + ofPoint(-kArrowSize, kArrowSize);
-            break;
-            
-        case kAnchorRight :
-            first = anchorPos + ofPoint(kArrowSize, -kArrowSize);
-            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
-            break;
-            
-        case kAnchorBottomCentre :
-            first = anchorPos + ofPoint(-kArrowSize, kArrowSize);
-            second = anchorPos + ofPoint(kArrowSize, kArrowSize);
-            break;
-            
-        case kAnchorTopCentre :
-            first = anchorPos + ofPoint(-kArrowSize, -kArrowSize);
-            second = anchorPos + ofPoint(kArrowSize, -kArrowSize);
-            break;
-            
-        default :
-            break;
-            
-    }
-    if (kAnchorUnknown != anchor)
+    if (calculateTargetAnchor(anchor, anchorPos, first, second))
     {
         ofLine(anchorPos, first);
         ofLine(anchorPos, second);
@@ -467,6 +537,49 @@ PortEntry::getCentre(void)
     return ofPoint(outer.x + (outer.width / 2), outer.y + (outer.height / 2));
 } // PortEntry::getCentre
 
+PortEntry::ConnectionGeometry &
+PortEntry::getOutputGeometry(const size_t index)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("index = ", index); //####
+    PortConnection &     aConnection = _outputConnections[index];
+    ConnectionGeometry & geometry = aConnection._geometry;
+    PortEntry *          otherEntry = aConnection._otherPort;
+    unsigned int         sourceVersion = versionForPort(this);
+    unsigned int         targetVersion = versionForPort(otherEntry);
+    
+    if ((geometry._sourceVersion != sourceVersion) || (geometry._targetVersion != targetVersion))
+    {
+        ofPoint aCentre(getCentre());
+        ofPoint otherCentre(otherEntry->getCentre());
+        
+        // Check if the destination is above the source, in which case we determine the anchors in
+        // the reverse order.
+        if (aCentre.y < otherCentre.y)
+        {
+            geometry._anchorHere = calculateClosestAnchor(geometry._fromHere, true, false,
+                                                          otherCentre);
+            geometry._anchorThere = otherEntry->calculateClosestAnchor(geometry._toThere, false,
+                                                        kAnchorBottomCentre == geometry._anchorHere,
+                                                                       aCentre);
+        }
+        else
+        {
+            geometry._anchorThere = otherEntry->calculateClosestAnchor(geometry._toThere, false,
+                                                                       false, aCentre);
+            geometry._anchorHere = calculateClosestAnchor(geometry._fromHere, true,
+                                                       kAnchorBottomCentre == geometry._anchorThere,
+                                                          otherCentre);
+        }
+        CalculateBezier(geometry._curve, geometry._fromHere, geometry._toThere, aCentre,
+                        otherCentre);
+        geometry._sourceVersion = sourceVersion;
+        geometry._targetVersion = targetVersion;
+    }
+    ODL_OBJEXIT_P(&geometry); //####
+    return geometry;
+} // PortEntry::getOutputGeometry
+
 bool
 PortEntry::isPointInside(const ofPoint & aPoint)
 const
@@ -117,6 +117,32 @@ public :
         
     }; // PortUsage
     
+    /*! @brief The calculated shape of a connection. */
+    struct ConnectionGeometry
+    {
+        /*! @brief The curve between the two anchors. */
+        ofPolyline _curve;
+        
+        /*! @brief The position of the anchor at the source. */
+        ofPoint _fromHere;
+        
+        /*! @brief The position of the anchor at the destination. */
+        ofPoint _toThere;
+        
+        /*! @brief The side of the source to which the anchor is attached. */
+        AnchorSide _anchorHere;
+        
+        /*! @brief The side of the destination to which the anchor is attached. */
+        AnchorSide _anchorThere;
+        
+        /*! @brief The version of the source entity when the shape was calculated. */
+        unsigned int _sourceVersion;
+        
+        /*! @brief The version of the destination entity when the shape was calculated. */
+        unsigned int _targetVersion;
+        
+    }; // ConnectionGeometry
+    
     /*! @brief The form of a connection. */
     struct PortConnection
     {
@@ -126,6 +152,9 @@ public :
         /*! @brief The kind of connection. */
         MplusM::Common::ChannelMode _connectionMode;
         
+        /*! @brief The calculated shape of the connection, for output connections. */
+        ConnectionGeometry _geometry;
+        
     }; // PortConnection
     
     /*! @brief The set of connections to the port. */
@@ -229,6 +258,13 @@ public :
         return _outputConnections;
     } // getOutputConnections
     
+    /*! @brief Return the shape of an output connection, recalculating it if either end has moved
+     since it was last calculated.
+     @param index The position of the connection in the set of output connections.
+     @returns The shape of the output connection. */
+    ConnectionGeometry &
+    getOutputGeometry(const size_t index);
+    
     inline PortPanel *
     getParent(void)
     const
@@ -375,6 +411,30 @@ public :
         _isLastPort = false;
     } // unsetAsLastPort
     
+    /*! @brief Calculate the arrowhead for an anchor leaving the given location.
+     @param anchor The side to which the anchor is attached.
+     @param anchorPos The coordinates of the anchor point.
+     @param first The far end of the first arrowhead line.
+     @param second The far end of the second arrowhead line.
+     @returns @c true if the anchor has an arrowhead and @c false otherwise. */
+    static bool
+    calculateSourceAnchor(const AnchorSide anchor,
+                          const ofPoint &  anchorPos,
+                          ofPoint &        first,
+                          ofPoint &        second);
+    
+    /*! @brief Calculate the arrowhead for an anchor arriving at the given location.
+     @param anchor The side to which the anchor is attached.
+     @param anchorPos The coordinates of the anchor point.
+     @param first The far end of the first arrowhead line.
+     @param second The far end of the second arrowhead line.
+     @returns @c true if the anchor has an arrowhead and @c false otherwise. */
+    static bool
+    calculateTargetAnchor(const AnchorSide anchor,
+                          const ofPoint &  anchorPos,
+                          ofPoint &        first,
+                          ofPoint &        second);
+    
     /*! @brief Displays an anchor leaving the given location.
      @param anchor The side to which the anchor is attached.
      @param anchorPos The coordinates of the anchor point. */
@@ -113,7 +113,6 @@ PortPanel::PortPanel(const EntityKind         kind,
 PortPanel::~PortPanel(void)
 {
     ODL_OBJENTER(); //####
-    unregisterMouseEvents();
     for (int ii = 0, mm = getNumPorts(); mm > ii; ++ii)
     {
         PortEntry * aPort = getPort(ii);
@@ -403,10 +402,11 @@ PortPanel::setup(string      collectionName,
                  const float yy)
 {
     ODL_OBJENTER(); //####
-    registerMouseEvents();
     PortPanel * result = static_cast<PortPanel *> (inherited::setup(collectionName, filename, xx,
                                                                     yy));
     
+    // The application delivers the mouse events, so the panel does not listen for them itself.
+    unregisterMouseEvents();
     ODL_OBJEXIT_P(result); //####
     return result;
 } // PortPanel::setup
@@ -418,9 +418,10 @@ PortPanel::setup(const ofParameterGroup & parameters,
                  const float              yy)
 {
     ODL_OBJENTER(); //####
-    registerMouseEvents();
     PortPanel * result = static_cast<PortPanel *> (inherited::setup(parameters, filename, xx, yy));
     
+    // The application delivers the mouse events, so the panel does not listen for them itself.
+    unregisterMouseEvents();
     ODL_OBJEXIT_P(result); //####
     return result;
 } // PortPanel::setup
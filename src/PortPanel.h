@@ -58,7 +58,10 @@ class MovementTracker;
 class ServiceEntity;
 class ServiceViewerApp;
 
-/*! @brief A GUI element to represent a set of ports. */
+/*! @brief A GUI element to represent a set of ports.
+ 
+ The panel does not listen for mouse events itself; the application delivers them to the panel
+ that is under the mouse or that is being dragged. */
 class PortPanel : protected IconlessPanel
 {
 public :
@@ -167,6 +170,15 @@ public :
         return inherited::getHeight();
     } // getHeight
     
+    /*! @brief Returns the kind of entity that the panel represents.
+     @returns The kind of entity that the panel represents. */
+    inline EntityKind
+    getKind(void)
+    const
+    {
+        return _kind;
+    } // getKind
+    
     /*! @brief Returns the name of the panel.
      @returns The name of the panel. */
     inline string
@@ -0,0 +1,479 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       RecordingScanSource.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for recording the results of scanning a network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "RecordingScanSource.h"
+#include "Utilities.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+
+#include <sstream>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for recording the results of scanning a network. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Add a set of channels to a record, preceded by their number.
+ @param output The record being built.
+ @param channels The channels to be added. */
+static void
+appendChannels(std::ostream &                        output,
+               const MplusM::Common::ChannelVector & channels)
+{
+    output << "\t" << channels.size();
+    for (MplusM::Common::ChannelVector::const_iterator walker(channels.begin());
+         channels.end() != walker; ++walker)
+    {
+        output << "\t" << EscapeForRecording(walker->_portName.c_str()) << "\t" <<
+                    EscapeForRecording(walker->_portProtocol.c_str()) << "\t" << walker->_portMode;
+    }
+} // appendChannels
+
+/*! @brief Add a set of names to a record, preceded by their number.
+ @param output The record being built.
+ @param names The names to be added. */
+static void
+appendNames(std::ostream &                       output,
+            const MplusM::Common::StringVector & names)
+{
+    output << "\t" << names.size();
+    for (MplusM::Common::StringVector::const_iterator walker(names.begin());
+         names.end() != walker; ++walker)
+    {
+        output << "\t" << EscapeForRecording(walker->c_str());
+    }
+} // appendNames
+
+/*! @brief Check if two sets of channels are the same.
+ @param first The first set of channels.
+ @param second The second set of channels.
+ @returns @c true if the two sets of channels are the same and @c false otherwise. */
+static bool
+channelsMatch(const MplusM::Common::ChannelVector & first,
+              const MplusM::Common::ChannelVector & second)
+{
+    bool result = (first.size() == second.size());
+    
+    for (size_t ii = 0, mm = first.size(); result && (mm > ii); ++ii)
+    {
+        const MplusM::Common::ChannelDescription & firstChannel = first[ii];
+        const MplusM::Common::ChannelDescription & secondChannel = second[ii];
+        
+        result = (firstChannel._portName == secondChannel._portName) &&
+                    (firstChannel._portProtocol == secondChannel._portProtocol) &&
+                    (firstChannel._portMode == secondChannel._portMode);
+    }
+    return result;
+} // channelsMatch
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+RecordingScanSource::RecordingScanSource(ScanSource *   source,
+                                         const string & filePath) :
+    inherited(), _source(source), _filePath(filePath), _output(), _lock(), _lastConnections(),
+    _lastDirections(), _checkActive(false), _checkRecorded(false)
+{
+    ODL_ENTER(); //####
+    ODL_P1("source = ", source); //####
+    ODL_S1s("filePath = ", filePath); //####
+    ODL_EXIT_P(this); //####
+} // RecordingScanSource::RecordingScanSource
+
+RecordingScanSource::~RecordingScanSource(void)
+{
+    ODL_OBJENTER(); //####
+    if (_output.is_open())
+    {
+        _output.close();
+    }
+    delete _source;
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::~RecordingScanSource
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+RecordingScanSource::addConnection(const yarp::os::ConstString & sourceName,
+                                   const yarp::os::ConstString & destinationName,
+                                   const bool                    isUDP)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    ODL_B1("isUDP = ", isUDP); //####
+    // Changes made by the user are not recorded; their effects appear in the following scans.
+    bool result = _source->addConnection(sourceName, destinationName, isUDP);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::addConnection
+
+void
+RecordingScanSource::beginConnectionCheck(void)
+{
+    ODL_OBJENTER(); //####
+    _source->beginConnectionCheck();
+    // The start of the check is only recorded once a change has been found.
+    _lock.lock();
+    _checkActive = true;
+    _checkRecorded = false;
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::beginConnectionCheck
+
+bool
+RecordingScanSource::checkForRegistryService(const MplusM::Utilities::PortVector & detectedPorts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    bool               result = _source->checkForRegistryService(detectedPorts);
+    std::ostringstream record;
+    
+    record << RECORDING_REGISTRY_TAG "\t" << (result ? 1 : 0);
+    writeRecord(record.str());
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::checkForRegistryService
+
+void
+RecordingScanSource::gatherPortConnections(const yarp::os::ConstString &   portName,
+                                           MplusM::Common::ChannelVector & outputs,
+                                           MplusM::Common::CheckFunction   checker,
+                                           void *                          checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("outputs = ", &outputs, "checkStuff = ", checkStuff); //####
+    bool               changed;
+    bool               wanted;
+    std::ostringstream record;
+    
+    _source->gatherPortConnections(portName, outputs, checker, checkStuff);
+    _lock.lock();
+    ConnectionsMap::iterator match(_lastConnections.find(portName.c_str()));
+    
+    if (_lastConnections.end() == match)
+    {
+        _lastConnections[portName.c_str()] = outputs;
+        changed = true;
+    }
+    else if (channelsMatch(match->second, outputs))
+    {
+        changed = false;
+    }
+    else
+    {
+        match->second = outputs;
+        changed = true;
+    }
+    // A full scan records every port, while a check only records the ports that have changed.
+    wanted = (changed || (! _checkActive));
+    if (wanted && _checkActive && (! _checkRecorded))
+    {
+        record << RECORDING_CHECK_TAG "\t" << ofGetUnixTime() << "\n";
+        _checkRecorded = true;
+    }
+    _lock.unlock();
+    if (wanted)
+    {
+        record << RECORDING_CONNECTIONS_TAG "\t" << EscapeForRecording(portName.c_str());
+        appendChannels(record, outputs);
+        writeRecord(record.str());
+    }
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::gatherPortConnections
+
+bool
+RecordingScanSource::getAssociatedPorts(const yarp::os::ConstString &        portName,
+                                        MplusM::Utilities::PortAssociation & associates,
+                                        MplusM::Common::CheckFunction        checker,
+                                        void *                               checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("associates = ", &associates, "checkStuff = ", checkStuff); //####
+    bool               result = _source->getAssociatedPorts(portName, associates, checker,
+                                                            checkStuff);
+    std::ostringstream record;
+    
+    record << RECORDING_ASSOCIATES_TAG "\t" << EscapeForRecording(portName.c_str()) << "\t" <<
+                (result ? 1 : 0) << "\t" << (associates._primary ? 1 : 0) << "\t" <<
+                (associates._valid ? 1 : 0);
+    appendNames(record, associates._inputs);
+    appendNames(record, associates._outputs);
+    writeRecord(record.str());
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::getAssociatedPorts
+
+void
+RecordingScanSource::getDetectedPortList(MplusM::Utilities::PortVector & detectedPorts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    std::ostringstream record;
+    
+    _source->getDetectedPortList(detectedPorts);
+    // The list of ports is the first thing retrieved by each scan.
+    record << RECORDING_SCAN_TAG "\t" << ofGetUnixTime();
+    for (MplusM::Utilities::PortVector::const_iterator walker(detectedPorts.begin());
+         detectedPorts.end() != walker; ++walker)
+    {
+        record << "\n" RECORDING_PORT_TAG "\t" << EscapeForRecording(walker->_portName.c_str()) <<
+                    "\t" << EscapeForRecording(walker->_portIpAddress.c_str()) << "\t" <<
+                    EscapeForRecording(walker->_portPortNumber.c_str());
+    }
+    _lock.lock();
+    // The previous scan is made available to readers before the next one is started.
+    _output.flush();
+    _checkActive = false;
+    _lastConnections.clear();
+    _lock.unlock();
+    writeRecord(record.str());
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::getDetectedPortList
+
+bool
+RecordingScanSource::getNameAndDescriptionForService(const yarp::os::ConstString &          serviceName,
+                                                     MplusM::Utilities::ServiceDescriptor & descriptor,
+                                                     MplusM::Common::CheckFunction          checker,
+                                                     void *                                 checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("serviceName = ", serviceName); //####
+    ODL_P2("descriptor = ", &descriptor, "checkStuff = ", checkStuff); //####
+    bool               result = _source->getNameAndDescriptionForService(serviceName, descriptor,
+                                                                         checker, checkStuff);
+    std::ostringstream record;
+    
+    record << RECORDING_DESCRIPTOR_TAG "\t" << EscapeForRecording(serviceName.c_str()) << "\t" <<
+                (result ? 1 : 0) << "\t" << EscapeForRecording(descriptor._serviceName.c_str()) <<
+                "\t" << EscapeForRecording(descriptor._channelName.c_str()) << "\t" <<
+                EscapeForRecording(descriptor._kind.c_str()) << "\t" <<
+                EscapeForRecording(descriptor._description.c_str()) << "\t" <<
+                EscapeForRecording(descriptor._requestsDescription.c_str()) << "\t" <<
+                EscapeForRecording(descriptor._path.c_str());
+    appendChannels(record, descriptor._inputChannels);
+    appendChannels(record, descriptor._outputChannels);
+    writeRecord(record.str());
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::getNameAndDescriptionForService
+
+bool
+RecordingScanSource::getServiceNames(MplusM::Common::StringVector & services,
+                                     MplusM::Common::CheckFunction  checker,
+                                     void *                         checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("services = ", &services, "checkStuff = ", checkStuff); //####
+    bool               result = _source->getServiceNames(services, checker, checkStuff);
+    std::ostringstream record;
+    
+    record << RECORDING_SERVICES_TAG "\t" << (result ? 1 : 0);
+    for (MplusM::Common::StringVector::const_iterator walker(services.begin());
+         services.end() != walker; ++walker)
+    {
+        record << "\n" RECORDING_SERVICE_TAG "\t" << EscapeForRecording(walker->c_str());
+    }
+    writeRecord(record.str());
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::getServiceNames
+
+bool
+RecordingScanSource::lookupDirection(const yarp::os::ConstString & portName,
+                                     PortEntry::PortDirection &    direction)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P1("direction = ", &direction); //####
+    // The directions are recorded once they are settled, in rememberDirection().
+    bool result = _source->lookupDirection(portName, direction);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::lookupDirection
+
+void
+RecordingScanSource::rememberDirection(const yarp::os::ConstString &  portName,
+                                       const PortEntry::PortDirection direction)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_L1("direction = ", direction); //####
+    bool               changed;
+    std::ostringstream record;
+    
+    _source->rememberDirection(portName, direction);
+    _lock.lock();
+    DirectionMap::iterator match(_lastDirections.find(portName.c_str()));
+    
+    if (_lastDirections.end() == match)
+    {
+        _lastDirections[portName.c_str()] = direction;
+        changed = true;
+    }
+    else if (match->second == direction)
+    {
+        changed = false;
+    }
+    else
+    {
+        match->second = direction;
+        changed = true;
+    }
+    _lock.unlock();
+    // Replay uses the most recently recorded direction, so only the changes are needed.
+    if (changed)
+    {
+        record << RECORDING_DIRECTION_TAG "\t" << EscapeForRecording(portName.c_str()) << "\t" <<
+                    direction;
+        writeRecord(record.str());
+    }
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::rememberDirection
+
+bool
+RecordingScanSource::removeConnection(const yarp::os::ConstString & sourceName,
+                                      const yarp::os::ConstString & destinationName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    bool result = _source->removeConnection(sourceName, destinationName);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::removeConnection
+
+void
+RecordingScanSource::removeStalePorts(void)
+{
+    ODL_OBJENTER(); //####
+    _source->removeStalePorts();
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::removeStalePorts
+
+bool
+RecordingScanSource::requiresDirectionProbing(void)
+const
+{
+    ODL_OBJENTER(); //####
+    bool result = _source->requiresDirectionProbing();
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::requiresDirectionProbing
+
+bool
+RecordingScanSource::start(void)
+{
+    ODL_OBJENTER(); //####
+    bool result;
+    
+    _output.open(_filePath.c_str());
+    if (_output)
+    {
+        _output << RECORDING_HEADER_TAG "\t" << RECORDING_VERSION << "\n";
+        result = _source->start();
+    }
+    else
+    {
+        ODL_LOG("! (_output)"); //####
+        result = false;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // RecordingScanSource::start
+
+void
+RecordingScanSource::stop(void)
+{
+    ODL_OBJENTER(); //####
+    _source->stop();
+    _lock.lock();
+    if (_output.is_open())
+    {
+        _output.close();
+    }
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::stop
+
+void
+RecordingScanSource::writeRecord(const string & record)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("record = ", record); //####
+    _lock.lock();
+    if (_output.is_open())
+    {
+        _output << record << "\n";
+    }
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // RecordingScanSource::writeRecord
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
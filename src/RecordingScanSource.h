@@ -0,0 +1,302 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       RecordingScanSource.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for recording the results of scanning a network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__RecordingScanSource__))
+# define __ServiceViewer__RecordingScanSource__  /* Header guard */
+
+# include "ScanSource.h"
+
+# include "ofTypes.h"
+
+# include <fstream>
+# include <map>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for recording the results of scanning a network. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief The tag that begins a scan recording, followed by the version of the format. */
+# define RECORDING_HEADER_TAG "serviceViewerScans"
+
+/*! @brief The version of the format of a scan recording. */
+# define RECORDING_VERSION 2
+
+/*! @brief The tag for the associates of a port. */
+# define RECORDING_ASSOCIATES_TAG "associates"
+
+/*! @brief The tag for the start of a check of the connections between full scans. */
+# define RECORDING_CHECK_TAG "check"
+
+/*! @brief The tag for the ports that a port is sending to. */
+# define RECORDING_CONNECTIONS_TAG "connections"
+
+/*! @brief The tag for the descriptor of a service. */
+# define RECORDING_DESCRIPTOR_TAG "descriptor"
+
+/*! @brief The tag for the direction of a port. */
+# define RECORDING_DIRECTION_TAG "direction"
+
+/*! @brief The tag for a port that is present. */
+# define RECORDING_PORT_TAG "port"
+
+/*! @brief The tag for the presence of the Registry Service. */
+# define RECORDING_REGISTRY_TAG "registry"
+
+/*! @brief The tag for the start of a scan. */
+# define RECORDING_SCAN_TAG "scan"
+
+/*! @brief The tag for the name of a service port that is present. */
+# define RECORDING_SERVICE_TAG "service"
+
+/*! @brief The tag for the success of the retrieval of the names of the service ports. */
+# define RECORDING_SERVICES_TAG "services"
+
+/*! @brief Recording the results of scanning a network.
+ 
+ The requests are passed on to another source, and the results are written to a file, so that
+ they can be replayed later by a ReplayScanSource. Each result is a single line, with a tag and
+ then the fields separated by tabs, and each scan begins when the list of ports is retrieved. The
+ file is flushed as each scan begins, so that a recording is usable even if the application does
+ not stop normally.
+ 
+ The checks of the connections between full scans are only recorded when they find a change, and
+ then only for the ports whose connections have changed, each check beginning with its own tag.
+ The direction of a port is only recorded when it changes. */
+class RecordingScanSource : public ScanSource
+{
+public :
+    
+    /*! @brief The constructor.
+     @param source The network to be scanned; the recorder takes ownership of it.
+     @param filePath The path to the file to be replaced with the recording. */
+    RecordingScanSource(ScanSource *   source,
+                        const string & filePath);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~RecordingScanSource(void);
+    
+    /*! @brief Connect two ports.
+     @param sourceName The name of the source port.
+     @param destinationName The name of the destination port.
+     @param isUDP @c true if the connection is to use UDP and @c false otherwise.
+     @returns @c true if the connection was made and @c false otherwise. */
+    virtual bool
+    addConnection(const yarp::os::ConstString & sourceName,
+                  const yarp::os::ConstString & destinationName,
+                  const bool                    isUDP);
+    
+    /*! @brief Note that the connections between the known ports are about to be checked, without
+     a full scan. */
+    virtual void
+    beginConnectionCheck(void);
+    
+    /*! @brief Check if the Registry Service is present.
+     @param detectedPorts The set of detected ports.
+     @returns @c true if the Registry Service is present and @c false otherwise. */
+    virtual bool
+    checkForRegistryService(const MplusM::Utilities::PortVector & detectedPorts);
+    
+    /*! @brief Retrieve the ports that a port is sending to.
+     @param portName The name of the port.
+     @param outputs The ports that the port is sending to.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    virtual void
+    gatherPortConnections(const yarp::os::ConstString &   portName,
+                          MplusM::Common::ChannelVector & outputs,
+                          MplusM::Common::CheckFunction   checker,
+                          void *                          checkStuff);
+    
+    /*! @brief Retrieve the associates of a port.
+     @param portName The name of the port.
+     @param associates The associates of the port.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the associates were retrieved and @c false otherwise. */
+    virtual bool
+    getAssociatedPorts(const yarp::os::ConstString &        portName,
+                       MplusM::Utilities::PortAssociation & associates,
+                       MplusM::Common::CheckFunction        checker,
+                       void *                               checkStuff);
+    
+    /*! @brief Retrieve the ports that are present.
+     @param detectedPorts The set of detected ports. */
+    virtual void
+    getDetectedPortList(MplusM::Utilities::PortVector & detectedPorts);
+    
+    /*! @brief Retrieve the descriptor of a service.
+     @param serviceName The name of the service port.
+     @param descriptor The descriptor of the service.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the descriptor was retrieved and @c false otherwise. */
+    virtual bool
+    getNameAndDescriptionForService(const yarp::os::ConstString &          serviceName,
+                                    MplusM::Utilities::ServiceDescriptor & descriptor,
+                                    MplusM::Common::CheckFunction          checker,
+                                    void *                                 checkStuff);
+    
+    /*! @brief Retrieve the names of the service ports that are present.
+     @param services The names of the service ports.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the names were retrieved and @c false otherwise. */
+    virtual bool
+    getServiceNames(MplusM::Common::StringVector & services,
+                    MplusM::Common::CheckFunction  checker,
+                    void *                         checkStuff);
+    
+    /*! @brief Find the direction of a port without testing it.
+     @param portName The name of the port.
+     @param direction The direction of the port, if it is known.
+     @returns @c true if the direction of the port is known and @c false if it must be determined
+     by testing the port. */
+    virtual bool
+    lookupDirection(const yarp::os::ConstString & portName,
+                    PortEntry::PortDirection &    direction);
+    
+    /*! @brief Note the direction of a port that is not part of a service, however it was
+     determined.
+     @param portName The name of the port.
+     @param direction The direction of the port. */
+    virtual void
+    rememberDirection(const yarp::os::ConstString &  portName,
+                      const PortEntry::PortDirection direction);
+    
+    /*! @brief Disconnect two ports.
+     @param sourceName The name of the source port.
+     @param destinationName The name of the destination port.
+     @returns @c true if the connection was removed and @c false otherwise. */
+    virtual bool
+    removeConnection(const yarp::os::ConstString & sourceName,
+                     const yarp::os::ConstString & destinationName);
+    
+    /*! @brief Remove the ports that are no longer responding. */
+    virtual void
+    removeStalePorts(void);
+    
+    /*! @brief Returns @c true if the directions of ports must be determined by testing them.
+     @returns @c true if the directions of ports must be determined by testing them and @c false
+     if they are all known ahead of time. */
+    virtual bool
+    requiresDirectionProbing(void)
+    const;
+    
+    /*! @brief Prepare the network to be scanned.
+     @returns @c true if the network can be scanned and @c false otherwise. */
+    virtual bool
+    start(void);
+    
+    /*! @brief Release the resources used to scan the network. */
+    virtual void
+    stop(void);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(RecordingScanSource);
+    
+    /*! @brief A mapping from port names to the ports that they are sending to. */
+    typedef std::map<string, MplusM::Common::ChannelVector> ConnectionsMap;
+    
+    /*! @brief A mapping from port names to their directions. */
+    typedef std::map<string, PortEntry::PortDirection> DirectionMap;
+    
+    /*! @brief Write a result to the recording.
+     @param record The result, as a single line without a line ending. */
+    void
+    writeRecord(const string & record);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The class that this class is derived from. */
+    typedef ScanSource inherited;
+    
+    /*! @brief The network being scanned. */
+    ScanSource * _source;
+    
+    /*! @brief The path to the recording. */
+    string _filePath;
+    
+    /*! @brief The recording. */
+    std::ofstream _output;
+    
+    /*! @brief Control access to the recording. */
+    ofMutex _lock;
+    
+    /*! @brief The most recently recorded connections of each port. */
+    ConnectionsMap _lastConnections;
+    
+    /*! @brief The most recently recorded direction of each port. */
+    DirectionMap _lastDirections;
+    
+    /*! @brief @c true if the connections are being checked between full scans and @c false if a
+     full scan is in progress. */
+    bool _checkActive;
+    
+    /*! @brief @c true if the start of the current check of the connections has been recorded and
+     @c false otherwise. */
+    bool _checkRecorded;
+    
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+    /*! @brief Filler to pad to alignment boundary */
+    char _filler[6];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+    
+}; // RecordingScanSource
+
+#endif // ! defined(__ServiceViewer__RecordingScanSource__)
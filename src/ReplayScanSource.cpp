@@ -0,0 +1,562 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ReplayScanSource.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for replaying the results of scanning a network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ReplayScanSource.h"
+#include "RecordingScanSource.h"
+#include "Utilities.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for replaying the results of scanning a network. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Read a set of channels from a record, preceded by their number.
+ @param fields The fields of the record.
+ @param index The index of the number of channels, which is updated to follow the channels.
+ @param channels The channels that were read.
+ @returns @c true if the channels were read and @c false if the record is too short. */
+static bool
+readChannels(const std::vector<string> &     fields,
+             size_t &                        index,
+             MplusM::Common::ChannelVector & channels)
+{
+    bool result = (fields.size() > index);
+    
+    if (result)
+    {
+        size_t count = static_cast<size_t> (std::max(0, ofToInt(fields[index++])));
+        
+        result = ((fields.size() - index) >= (3 * count));
+        for (size_t ii = 0; result && (count > ii); ++ii)
+        {
+            MplusM::Common::ChannelDescription aChannel;
+            
+            aChannel._portName = fields[index++].c_str();
+            aChannel._portProtocol = fields[index++].c_str();
+            aChannel._portMode =
+                        static_cast<MplusM::Common::ChannelMode> (ofToInt(fields[index++]));
+            channels.push_back(aChannel);
+        }
+    }
+    return result;
+} // readChannels
+
+/*! @brief Read a set of names from a record, preceded by their number.
+ @param fields The fields of the record.
+ @param index The index of the number of names, which is updated to follow the names.
+ @param names The names that were read.
+ @returns @c true if the names were read and @c false if the record is too short. */
+static bool
+readNames(const std::vector<string> &    fields,
+          size_t &                       index,
+          MplusM::Common::StringVector & names)
+{
+    bool result = (fields.size() > index);
+    
+    if (result)
+    {
+        size_t count = static_cast<size_t> (std::max(0, ofToInt(fields[index++])));
+        
+        result = ((fields.size() - index) >= count);
+        for (size_t ii = 0; result && (count > ii); ++ii)
+        {
+            names.push_back(fields[index++].c_str());
+        }
+    }
+    return result;
+} // readNames
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ReplayScanSource::ReplayScanSource(const string & filePath) :
+    inherited(), _filePath(filePath), _scans(), _currentScan(0), _nextScan(0), _checksStarted(0)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("filePath = ", filePath); //####
+    ODL_EXIT_P(this); //####
+} // ReplayScanSource::ReplayScanSource
+
+ReplayScanSource::~ReplayScanSource(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ReplayScanSource::~ReplayScanSource
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+ReplayScanSource::addConnection(const yarp::os::ConstString & sourceName,
+                                const yarp::os::ConstString & destinationName,
+                                const bool                    isUDP)
+{
+#if MAC_OR_LINUX_
+# pragma unused(sourceName,destinationName,isUDP)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    ODL_B1("isUDP = ", isUDP); //####
+    // A recording cannot be changed.
+    ODL_OBJEXIT_B(false); //####
+    return false;
+} // ReplayScanSource::addConnection
+
+void
+ReplayScanSource::beginConnectionCheck(void)
+{
+    ODL_OBJENTER(); //####
+    // Once the recorded checks run out, the last one is repeated until the next scan.
+    if ((_scans.size() > _currentScan) &&
+        (_scans[_currentScan]._checks.size() > _checksStarted))
+    {
+        ++_checksStarted;
+    }
+    ODL_OBJEXIT(); //####
+} // ReplayScanSource::beginConnectionCheck
+
+bool
+ReplayScanSource::checkForRegistryService(const MplusM::Utilities::PortVector & detectedPorts)
+{
+#if MAC_OR_LINUX_
+# pragma unused(detectedPorts)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    bool result = (_scans.size() > _currentScan) && _scans[_currentScan]._registryPresent;
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ReplayScanSource::checkForRegistryService
+
+void
+ReplayScanSource::gatherPortConnections(const yarp::os::ConstString &   portName,
+                                        MplusM::Common::ChannelVector & outputs,
+                                        MplusM::Common::CheckFunction   checker,
+                                        void *                          checkStuff)
+{
+#if MAC_OR_LINUX_
+# pragma unused(checker,checkStuff)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("outputs = ", &outputs, "checkStuff = ", checkStuff); //####
+    bool found = false;
+    
+    // The checks that have been started only record the ports that changed, so the earlier
+    // checks and then the scan itself are searched for the others.
+    if (_scans.size() > _currentScan)
+    {
+        const CheckList & checks = _scans[_currentScan]._checks;
+        
+        for (size_t ii = std::min(_checksStarted, checks.size()); (! found) && (0 < ii); --ii)
+        {
+            const ConnectionsMap &         recorded = checks[ii - 1];
+            ConnectionsMap::const_iterator match(recorded.find(portName.c_str()));
+            
+            if (recorded.end() != match)
+            {
+                outputs = match->second;
+                found = true;
+            }
+        }
+    }
+    for (size_t ii = std::min(_currentScan + 1, _scans.size()); (! found) && (0 < ii); --ii)
+    {
+        const ConnectionsMap &         recorded = _scans[ii - 1]._connections;
+        ConnectionsMap::const_iterator match(recorded.find(portName.c_str()));
+        
+        if (recorded.end() != match)
+        {
+            outputs = match->second;
+            found = true;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ReplayScanSource::gatherPortConnections
+
+bool
+ReplayScanSource::getAssociatedPorts(const yarp::os::ConstString &        portName,
+                                     MplusM::Utilities::PortAssociation & associates,
+                                     MplusM::Common::CheckFunction        checker,
+                                     void *                               checkStuff)
+{
+#if MAC_OR_LINUX_
+# pragma unused(checker,checkStuff)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("associates = ", &associates, "checkStuff = ", checkStuff); //####
+    bool found = false;
+    bool result = false;
+    
+    for (size_t ii = std::min(_currentScan + 1, _scans.size()); (! found) && (0 < ii); --ii)
+    {
+        const AssociatesMap &         recorded = _scans[ii - 1]._associates;
+        AssociatesMap::const_iterator match(recorded.find(portName.c_str()));
+        
+        if (recorded.end() != match)
+        {
+            associates = match->second._associates;
+            result = match->second._retrieved;
+            found = true;
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ReplayScanSource::getAssociatedPorts
+
+void
+ReplayScanSource::getDetectedPortList(MplusM::Utilities::PortVector & detectedPorts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    // The list of ports is the first thing retrieved by each scan, so the next recorded scan is
+    // started.
+    if (_scans.size() > _nextScan)
+    {
+        _currentScan = _nextScan;
+        _checksStarted = 0;
+        detectedPorts = _scans[_currentScan]._ports;
+        if (_scans.size() > (_nextScan + 1))
+        {
+            ++_nextScan;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ReplayScanSource::getDetectedPortList
+
+bool
+ReplayScanSource::getNameAndDescriptionForService(const yarp::os::ConstString &          serviceName,
+                                                  MplusM::Utilities::ServiceDescriptor & descriptor,
+                                                  MplusM::Common::CheckFunction          checker,
+                                                  void *                                 checkStuff)
+{
+#if MAC_OR_LINUX_
+# pragma unused(checker,checkStuff)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_S1s("serviceName = ", serviceName); //####
+    ODL_P2("descriptor = ", &descriptor, "checkStuff = ", checkStuff); //####
+    bool found = false;
+    bool result = false;
+    
+    for (size_t ii = std::min(_currentScan + 1, _scans.size()); (! found) && (0 < ii); --ii)
+    {
+        const DescriptorMap &         recorded = _scans[ii - 1]._descriptors;
+        DescriptorMap::const_iterator match(recorded.find(serviceName.c_str()));
+        
+        if (recorded.end() != match)
+        {
+            descriptor = match->second._descriptor;
+            result = match->second._retrieved;
+            found = true;
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ReplayScanSource::getNameAndDescriptionForService
+
+bool
+ReplayScanSource::getServiceNames(MplusM::Common::StringVector & services,
+                                  MplusM::Common::CheckFunction  checker,
+                                  void *                         checkStuff)
+{
+#if MAC_OR_LINUX_
+# pragma unused(checker,checkStuff)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_P2("services = ", &services, "checkStuff = ", checkStuff); //####
+    bool result = (_scans.size() > _currentScan) && _scans[_currentScan]._servicesRetrieved;
+    
+    if (result)
+    {
+        services = _scans[_currentScan]._serviceNames;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ReplayScanSource::getServiceNames
+
+bool
+ReplayScanSource::load(void)
+{
+    ODL_OBJENTER(); //####
+    bool          result = false;
+    std::ifstream input(_filePath.c_str());
+    
+    _scans.clear();
+    if (input)
+    {
+        string line;
+        
+        if (std::getline(input, line))
+        {
+            std::vector<string> fields(ofSplitString(line, "\t"));
+            
+            result = (2 <= fields.size()) && (RECORDING_HEADER_TAG == fields[0]) &&
+                        (1 <= ofToInt(fields[1])) && (RECORDING_VERSION >= ofToInt(fields[1]));
+        }
+        while (result && std::getline(input, line))
+        {
+            std::vector<string> fields(ofSplitString(line, "\t"));
+            
+            for (size_t ii = 0, mm = fields.size(); mm > ii; ++ii)
+            {
+                fields[ii] = UnescapeFromRecording(fields[ii]);
+            }
+            // Records that are not understood or are incomplete are skipped.
+            if (fields.empty())
+            {
+                ODL_LOG("(fields.empty())"); //####
+            }
+            else if (RECORDING_SCAN_TAG == fields[0])
+            {
+                RecordedScan aScan;
+                
+                aScan._registryPresent = aScan._servicesRetrieved = false;
+                _scans.push_back(aScan);
+            }
+            else if (_scans.empty())
+            {
+                ODL_LOG("(_scans.empty())"); //####
+            }
+            else
+            {
+                RecordedScan & aScan = _scans.back();
+                const string & tag = fields[0];
+                
+                if ((RECORDING_PORT_TAG == tag) && (4 <= fields.size()))
+                {
+                    MplusM::Utilities::PortDescriptor aPort;
+                    
+                    aPort._portName = fields[1].c_str();
+                    aPort._portIpAddress = fields[2].c_str();
+                    aPort._portPortNumber = fields[3].c_str();
+                    aScan._ports.push_back(aPort);
+                }
+                else if ((RECORDING_REGISTRY_TAG == tag) && (2 <= fields.size()))
+                {
+                    aScan._registryPresent = (0 != ofToInt(fields[1]));
+                }
+                else if ((RECORDING_SERVICES_TAG == tag) && (2 <= fields.size()))
+                {
+                    aScan._servicesRetrieved = (0 != ofToInt(fields[1]));
+                }
+                else if ((RECORDING_SERVICE_TAG == tag) && (2 <= fields.size()))
+                {
+                    aScan._serviceNames.push_back(fields[1].c_str());
+                }
+                else if ((RECORDING_DESCRIPTOR_TAG == tag) && (9 <= fields.size()))
+                {
+                    DescriptorRecord                       aRecord;
+                    MplusM::Utilities::ServiceDescriptor & descriptor = aRecord._descriptor;
+                    size_t                                 index = 9;
+                    
+                    aRecord._retrieved = (0 != ofToInt(fields[2]));
+                    descriptor._serviceName = fields[3].c_str();
+                    descriptor._channelName = fields[4].c_str();
+                    descriptor._kind = fields[5].c_str();
+                    descriptor._description = fields[6].c_str();
+                    descriptor._requestsDescription = fields[7].c_str();
+                    descriptor._path = fields[8].c_str();
+                    if (readChannels(fields, index, descriptor._inputChannels) &&
+                        readChannels(fields, index, descriptor._outputChannels))
+                    {
+                        aScan._descriptors[fields[1]] = aRecord;
+                    }
+                }
+                else if ((RECORDING_ASSOCIATES_TAG == tag) && (5 <= fields.size()))
+                {
+                    AssociatesRecord                     aRecord;
+                    MplusM::Utilities::PortAssociation & associates = aRecord._associates;
+                    size_t                               index = 5;
+                    
+                    aRecord._retrieved = (0 != ofToInt(fields[2]));
+                    associates._primary = (0 != ofToInt(fields[3]));
+                    associates._valid = (0 != ofToInt(fields[4]));
+                    if (readNames(fields, index, associates._inputs) &&
+                        readNames(fields, index, associates._outputs))
+                    {
+                        aScan._associates[fields[1]] = aRecord;
+                    }
+                }
+                else if (RECORDING_CHECK_TAG == tag)
+                {
+                    aScan._checks.push_back(ConnectionsMap());
+                }
+                else if ((RECORDING_CONNECTIONS_TAG == tag) && (2 <= fields.size()))
+                {
+                    MplusM::Common::ChannelVector outputs;
+                    size_t                        index = 2;
+                    
+                    if (readChannels(fields, index, outputs))
+                    {
+                        // The connections that follow a check belong to the check.
+                        if (aScan._checks.empty())
+                        {
+                            aScan._connections[fields[1]] = outputs;
+                        }
+                        else
+                        {
+                            aScan._checks.back()[fields[1]] = outputs;
+                        }
+                    }
+                }
+                else if ((RECORDING_DIRECTION_TAG == tag) && (3 <= fields.size()))
+                {
+                    aScan._directions[fields[1]] =
+                                    static_cast<PortEntry::PortDirection> (ofToInt(fields[2]));
+                }
+            }
+        }
+        result = (! _scans.empty());
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ReplayScanSource::load
+
+bool
+ReplayScanSource::lookupDirection(const yarp::os::ConstString & portName,
+                                  PortEntry::PortDirection &    direction)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P1("direction = ", &direction); //####
+    bool found = false;
+    
+    for (size_t ii = std::min(_currentScan + 1, _scans.size()); (! found) && (0 < ii); --ii)
+    {
+        const DirectionMap &         recorded = _scans[ii - 1]._directions;
+        DirectionMap::const_iterator match(recorded.find(portName.c_str()));
+        
+        if (recorded.end() != match)
+        {
+            direction = match->second;
+            found = true;
+        }
+    }
+    // Ports cannot be tested, so a port without a recorded direction stays unknown.
+    if (! found)
+    {
+        direction = PortEntry::kPortDirectionUnknown;
+    }
+    ODL_OBJEXIT_B(true); //####
+    return true;
+} // ReplayScanSource::lookupDirection
+
+bool
+ReplayScanSource::removeConnection(const yarp::os::ConstString & sourceName,
+                                   const yarp::os::ConstString & destinationName)
+{
+#if MAC_OR_LINUX_
+# pragma unused(sourceName,destinationName)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    // A recording cannot be changed.
+    ODL_OBJEXIT_B(false); //####
+    return false;
+} // ReplayScanSource::removeConnection
+
+void
+ReplayScanSource::removeStalePorts(void)
+{
+    ODL_OBJENTER(); //####
+    // The recorded ports are never stale.
+    ODL_OBJEXIT(); //####
+} // ReplayScanSource::removeStalePorts
+
+bool
+ReplayScanSource::requiresDirectionProbing(void)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT_B(false); //####
+    return false;
+} // ReplayScanSource::requiresDirectionProbing
+
+bool
+ReplayScanSource::start(void)
+{
+    ODL_OBJENTER(); //####
+    bool result = load();
+    
+    _currentScan = _nextScan = _checksStarted = 0;
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ReplayScanSource::start
+
+void
+ReplayScanSource::stop(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ReplayScanSource::stop
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
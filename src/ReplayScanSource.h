@@ -0,0 +1,300 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ReplayScanSource.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for replaying the results of scanning a network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ReplayScanSource__))
+# define __ServiceViewer__ReplayScanSource__  /* Header guard */
+
+# include "ScanSource.h"
+
+# include <map>
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for replaying the results of scanning a network. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief Replaying the results of scanning a network.
+ 
+ The scans written by a RecordingScanSource are read back, and each new scan that is started is
+ given the next recorded scan, until the last recorded scan is reached, which is then repeated.
+ Results that were not requested during a recorded scan, because they were cached, are taken from
+ the most recent earlier scan that has them. The recorded checks of the connections between full
+ scans are given, in order, to the checks that follow the scan, with the last one being repeated
+ until the next scan. The network is never touched, and the recording is not changed once it has
+ been loaded. */
+class ReplayScanSource : public ScanSource
+{
+public :
+    
+    /*! @brief The constructor.
+     @param filePath The path to the recording. */
+    explicit
+    ReplayScanSource(const string & filePath);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ReplayScanSource(void);
+    
+    /*! @brief Connect two ports.
+     @param sourceName The name of the source port.
+     @param destinationName The name of the destination port.
+     @param isUDP @c true if the connection is to use UDP and @c false otherwise.
+     @returns @c true if the connection was made and @c false otherwise. */
+    virtual bool
+    addConnection(const yarp::os::ConstString & sourceName,
+                  const yarp::os::ConstString & destinationName,
+                  const bool                    isUDP);
+    
+    /*! @brief Note that the connections between the known ports are about to be checked, without
+     a full scan. */
+    virtual void
+    beginConnectionCheck(void);
+    
+    /*! @brief Check if the Registry Service is present.
+     @param detectedPorts The set of detected ports.
+     @returns @c true if the Registry Service is present and @c false otherwise. */
+    virtual bool
+    checkForRegistryService(const MplusM::Utilities::PortVector & detectedPorts);
+    
+    /*! @brief Retrieve the ports that a port is sending to.
+     @param portName The name of the port.
+     @param outputs The ports that the port is sending to.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    virtual void
+    gatherPortConnections(const yarp::os::ConstString &   portName,
+                          MplusM::Common::ChannelVector & outputs,
+                          MplusM::Common::CheckFunction   checker,
+                          void *                          checkStuff);
+    
+    /*! @brief Retrieve the associates of a port.
+     @param portName The name of the port.
+     @param associates The associates of the port.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the associates were retrieved and @c false otherwise. */
+    virtual bool
+    getAssociatedPorts(const yarp::os::ConstString &        portName,
+                       MplusM::Utilities::PortAssociation & associates,
+                       MplusM::Common::CheckFunction        checker,
+                       void *                               checkStuff);
+    
+    /*! @brief Retrieve the ports that are present.
+     @param detectedPorts The set of detected ports. */
+    virtual void
+    getDetectedPortList(MplusM::Utilities::PortVector & detectedPorts);
+    
+    /*! @brief Retrieve the descriptor of a service.
+     @param serviceName The name of the service port.
+     @param descriptor The descriptor of the service.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the descriptor was retrieved and @c false otherwise. */
+    virtual bool
+    getNameAndDescriptionForService(const yarp::os::ConstString &          serviceName,
+                                    MplusM::Utilities::ServiceDescriptor & descriptor,
+                                    MplusM::Common::CheckFunction          checker,
+                                    void *                                 checkStuff);
+    
+    /*! @brief Retrieve the names of the service ports that are present.
+     @param services The names of the service ports.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the names were retrieved and @c false otherwise. */
+    virtual bool
+    getServiceNames(MplusM::Common::StringVector & services,
+                    MplusM::Common::CheckFunction  checker,
+                    void *                         checkStuff);
+    
+    /*! @brief Find the direction of a port without testing it.
+     @param portName The name of the port.
+     @param direction The direction of the port, if it is known.
+     @returns @c true if the direction of the port is known and @c false if it must be determined
+     by testing the port. */
+    virtual bool
+    lookupDirection(const yarp::os::ConstString & portName,
+                    PortEntry::PortDirection &    direction);
+    
+    /*! @brief Disconnect two ports.
+     @param sourceName The name of the source port.
+     @param destinationName The name of the destination port.
+     @returns @c true if the connection was removed and @c false otherwise. */
+    virtual bool
+    removeConnection(const yarp::os::ConstString & sourceName,
+                     const yarp::os::ConstString & destinationName);
+    
+    /*! @brief Remove the ports that are no longer responding. */
+    virtual void
+    removeStalePorts(void);
+    
+    /*! @brief Returns @c true if the directions of ports must be determined by testing them.
+     @returns @c true if the directions of ports must be determined by testing them and @c false
+     if they are all known ahead of time. */
+    virtual bool
+    requiresDirectionProbing(void)
+    const;
+    
+    /*! @brief Prepare the network to be scanned.
+     @returns @c true if the network can be scanned and @c false otherwise. */
+    virtual bool
+    start(void);
+    
+    /*! @brief Release the resources used to scan the network. */
+    virtual void
+    stop(void);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(ReplayScanSource);
+    
+    /*! @brief A recorded set of associates. */
+    struct AssociatesRecord
+    {
+        /*! @brief The associates of the port. */
+        MplusM::Utilities::PortAssociation _associates;
+        
+        /*! @brief @c true if the associates were retrieved and @c false otherwise. */
+        bool _retrieved;
+        
+    }; // AssociatesRecord
+    
+    /*! @brief A recorded service descriptor. */
+    struct DescriptorRecord
+    {
+        /*! @brief The descriptor of the service. */
+        MplusM::Utilities::ServiceDescriptor _descriptor;
+        
+        /*! @brief @c true if the descriptor was retrieved and @c false otherwise. */
+        bool _retrieved;
+        
+    }; // DescriptorRecord
+    
+    /*! @brief A mapping from port names to their recorded associates. */
+    typedef std::map<string, AssociatesRecord> AssociatesMap;
+    
+    /*! @brief A mapping from port names to their recorded connections. */
+    typedef std::map<string, MplusM::Common::ChannelVector> ConnectionsMap;
+    
+    /*! @brief A mapping from service port names to their recorded descriptors. */
+    typedef std::map<string, DescriptorRecord> DescriptorMap;
+    
+    /*! @brief A mapping from port names to their recorded directions. */
+    typedef std::map<string, PortEntry::PortDirection> DirectionMap;
+    
+    /*! @brief A sequence of recorded checks of the connections. */
+    typedef std::vector<ConnectionsMap> CheckList;
+    
+    /*! @brief The results of one recorded scan. */
+    struct RecordedScan
+    {
+        /*! @brief The ports that were present. */
+        MplusM::Utilities::PortVector _ports;
+        
+        /*! @brief The names of the service ports that were present. */
+        MplusM::Common::StringVector _serviceNames;
+        
+        /*! @brief The associates that were retrieved. */
+        AssociatesMap _associates;
+        
+        /*! @brief The connections that were retrieved. */
+        ConnectionsMap _connections;
+        
+        /*! @brief The connections that changed during the checks that followed the scan. */
+        CheckList _checks;
+        
+        /*! @brief The descriptors that were retrieved. */
+        DescriptorMap _descriptors;
+        
+        /*! @brief The directions that were determined. */
+        DirectionMap _directions;
+        
+        /*! @brief @c true if the Registry Service was present and @c false otherwise. */
+        bool _registryPresent;
+        
+        /*! @brief @c true if the names of the service ports were retrieved and @c false
+         otherwise. */
+        bool _servicesRetrieved;
+        
+    }; // RecordedScan
+    
+    /*! @brief A sequence of recorded scans. */
+    typedef std::vector<RecordedScan> ScanList;
+    
+    /*! @brief Read the recording.
+     @returns @c true if the recording was read and has at least one scan and @c false
+     otherwise. */
+    bool
+    load(void);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The class that this class is derived from. */
+    typedef ScanSource inherited;
+    
+    /*! @brief The path to the recording. */
+    string _filePath;
+    
+    /*! @brief The recorded scans. */
+    ScanList _scans;
+    
+    /*! @brief The index of the recorded scan being replayed. */
+    size_t _currentScan;
+    
+    /*! @brief The index of the recorded scan to be replayed by the next scan. */
+    size_t _nextScan;
+    
+    /*! @brief The number of recorded checks of the current scan that have been started. */
+    size_t _checksStarted;
+    
+}; // ReplayScanSource
+
+#endif // ! defined(__ServiceViewer__ReplayScanSource__)
@@ -0,0 +1,541 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanSnapshot.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for the results of a background scan.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ScanSnapshot.h"
+#include "Utilities.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for the results of a background scan. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief A mapping from connection keys to connections. */
+typedef std::map<string, const ScanSnapshot::ConnectionDetails *> ConnectionMap;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Check if two sets of associates are the same.
+ @param first The first set of associates.
+ @param second The second set of associates.
+ @returns @c true if the two sets of associates are the same and @c false otherwise. */
+static bool
+associatesMatch(const ScanSnapshot::PortAndAssociates & first,
+                const ScanSnapshot::PortAndAssociates & second)
+{
+    ODL_ENTER(); //####
+    ODL_P2("first = ", &first, "second = ", &second); //####
+    bool result = ((first._name == second._name) &&
+                   (first._associates._inputs == second._associates._inputs) &&
+                   (first._associates._outputs == second._associates._outputs));
+    
+    ODL_EXIT_B(result); //####
+    return result;
+} // associatesMatch
+
+/*! @brief Check if two sets of channels are the same.
+ @param first The first set of channels.
+ @param second The second set of channels.
+ @returns @c true if the two sets of channels are the same and @c false otherwise. */
+static bool
+channelsMatch(const MplusM::Common::ChannelVector & first,
+              const MplusM::Common::ChannelVector & second)
+{
+    ODL_ENTER(); //####
+    ODL_P2("first = ", &first, "second = ", &second); //####
+    bool result = (first.size() == second.size());
+    
+    for (size_t ii = 0, mm = first.size(); result && (mm > ii); ++ii)
+    {
+        result = ((first[ii]._portName == second[ii]._portName) &&
+                  (first[ii]._portProtocol == second[ii]._portProtocol));
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // channelsMatch
+
+/*! @brief Determine the differences between two collections.
+ @param older The older collection.
+ @param newer The newer collection.
+ @param added The keys of the entries that are only in the newer collection, or have changed.
+ @param removed The keys of the entries that are only in the older collection, or have changed.
+ @param isSame The function used to check if two entries with the same key are the same. */
+template <typename Collection>
+static void
+compareCollections(const Collection &      older,
+                   const Collection &      newer,
+                   ScanSnapshot::KeyList & added,
+                   ScanSnapshot::KeyList & removed,
+                   bool                    (* isSame)
+                                            (const typename Collection::mapped_type & first,
+                                             const typename Collection::mapped_type & second))
+{
+    ODL_ENTER(); //####
+    ODL_P4("older = ", &older, "newer = ", &newer, "added = ", &added, "removed = ", //####
+           &removed); //####
+    typename Collection::const_iterator oldWalker(older.begin());
+    typename Collection::const_iterator newWalker(newer.begin());
+    
+    // Both collections are sorted by key, so a single pass over each is sufficient.
+    while ((older.end() != oldWalker) || (newer.end() != newWalker))
+    {
+        if (newer.end() == newWalker)
+        {
+            removed.push_back(oldWalker->first);
+            ++oldWalker;
+        }
+        else if (older.end() == oldWalker)
+        {
+            added.push_back(newWalker->first);
+            ++newWalker;
+        }
+        else if (oldWalker->first < newWalker->first)
+        {
+            removed.push_back(oldWalker->first);
+            ++oldWalker;
+        }
+        else if (newWalker->first < oldWalker->first)
+        {
+            added.push_back(newWalker->first);
+            ++newWalker;
+        }
+        else
+        {
+            if (! isSame(oldWalker->second, newWalker->second))
+            {
+                removed.push_back(oldWalker->first);
+                added.push_back(newWalker->first);
+            }
+            ++oldWalker;
+            ++newWalker;
+        }
+    }
+    ODL_EXIT(); //####
+} // compareCollections
+
+/*! @brief Return the key to be used for a connection.
+ @param aConnection The connection of interest.
+ @returns The key to be used for the connection. */
+static string
+makeConnectionKey(const ScanSnapshot::ConnectionDetails & aConnection)
+{
+    return aConnection._outPortName + " " + aConnection._inPortName;
+} // makeConnectionKey
+
+/*! @brief Check if two standalone ports are the same.
+ @param first The first port.
+ @param second The second port.
+ @returns @c true if the two ports are the same and @c false otherwise. */
+static bool
+portsMatch(const ScanSnapshot::NameAndDirection & first,
+           const ScanSnapshot::NameAndDirection & second)
+{
+    ODL_ENTER(); //####
+    ODL_P2("first = ", &first, "second = ", &second); //####
+    bool result = ((first._name == second._name) && (first._direction == second._direction));
+    
+    ODL_EXIT_B(result); //####
+    return result;
+} // portsMatch
+
+/*! @brief Check if two services are the same.
+ @param first The first service.
+ @param second The second service.
+ @returns @c true if the two services are the same and @c false otherwise. */
+static bool
+servicesMatch(const MplusM::Utilities::ServiceDescriptor & first,
+              const MplusM::Utilities::ServiceDescriptor & second)
+{
+    ODL_ENTER(); //####
+    ODL_P2("first = ", &first, "second = ", &second); //####
+    bool result = ((first._serviceName == second._serviceName) &&
+                   (first._channelName == second._channelName) &&
+                   (first._kind == second._kind) &&
+                   (first._description == second._description) &&
+                   channelsMatch(first._inputChannels, second._inputChannels) &&
+                   channelsMatch(first._outputChannels, second._outputChannels));
+    
+    ODL_EXIT_B(result); //####
+    return result;
+} // servicesMatch
+
+/*! @brief Write a set of channels as a JSON array.
+ @param output The stream to write to.
+ @param channels The channels to be written. */
+static void
+writeChannelsAsJson(std::ostream &                        output,
+                    const MplusM::Common::ChannelVector & channels)
+{
+    ODL_ENTER(); //####
+    ODL_P2("output = ", &output, "channels = ", &channels); //####
+    output << "[";
+    for (MplusM::Common::ChannelVector::const_iterator walker(channels.begin());
+         channels.end() != walker; ++walker)
+    {
+        if (channels.begin() != walker)
+        {
+            output << ",";
+        }
+        output << "{\"name\":\"" << EscapeForJson(walker->_portName.c_str()) <<
+                    "\",\"protocol\":\"" << EscapeForJson(walker->_portProtocol.c_str()) <<
+                    "\",\"mode\":\"" << ScanSnapshot::getModeName(walker->_portMode) << "\"}";
+    }
+    output << "]";
+    ODL_EXIT(); //####
+} // writeChannelsAsJson
+
+/*! @brief Write a set of port names as a JSON array.
+ @param output The stream to write to.
+ @param names The port names to be written. */
+static void
+writeNamesAsJson(std::ostream &                       output,
+                 const MplusM::Common::StringVector & names)
+{
+    ODL_ENTER(); //####
+    ODL_P2("output = ", &output, "names = ", &names); //####
+    output << "[";
+    for (MplusM::Common::StringVector::const_iterator walker(names.begin());
+         names.end() != walker; ++walker)
+    {
+        if (names.begin() != walker)
+        {
+            output << ",";
+        }
+        output << "\"" << EscapeForJson(walker->c_str()) << "\"";
+    }
+    output << "]";
+    ODL_EXIT(); //####
+} // writeNamesAsJson
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+const char *
+ScanSnapshot::getDirectionName(const PortEntry::PortDirection direction)
+{
+    ODL_ENTER(); //####
+    ODL_L1("direction = ", direction); //####
+    const char * result;
+    
+    switch (direction)
+    {
+        case PortEntry::kPortDirectionInput :
+            result = "input";
+            break;
+        
+        case PortEntry::kPortDirectionInputOutput :
+            result = "inputOutput";
+            break;
+        
+        case PortEntry::kPortDirectionOutput :
+            result = "output";
+            break;
+        
+        default :
+            result = "unknown";
+            break;
+        
+    }
+    ODL_EXIT_S(result); //####
+    return result;
+} // ScanSnapshot::getDirectionName
+
+const char *
+ScanSnapshot::getModeName(const MplusM::Common::ChannelMode mode)
+{
+    ODL_ENTER(); //####
+    ODL_L1("mode = ", mode); //####
+    const char * result;
+    
+    switch (mode)
+    {
+        case MplusM::Common::kChannelModeTCP :
+            result = "tcp";
+            break;
+        
+        case MplusM::Common::kChannelModeUDP :
+            result = "udp";
+            break;
+        
+        default :
+            result = "other";
+            break;
+        
+    }
+    ODL_EXIT_S(result); //####
+    return result;
+} // ScanSnapshot::getModeName
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScanSnapshot::ScanSnapshot(void) :
+    _detectedServices(), _rememberedPorts(), _associatedPorts(), _standalonePorts(), _connections()
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // ScanSnapshot::ScanSnapshot
+
+ScanSnapshot::~ScanSnapshot(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ScanSnapshot::~ScanSnapshot
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ScanSnapshot::assign(const ScanSnapshot & other)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("other = ", &other); //####
+    if (this != &other)
+    {
+        _detectedServices = other._detectedServices;
+        _rememberedPorts = other._rememberedPorts;
+        _associatedPorts = other._associatedPorts;
+        _standalonePorts = other._standalonePorts;
+        _connections = other._connections;
+    }
+    ODL_OBJEXIT(); //####
+} // ScanSnapshot::assign
+
+void
+ScanSnapshot::clear(void)
+{
+    ODL_OBJENTER(); //####
+    _detectedServices.clear();
+    _rememberedPorts.clear();
+    _associatedPorts.clear();
+    _standalonePorts.clear();
+    _connections.clear();
+    ODL_OBJEXIT(); //####
+} // ScanSnapshot::clear
+
+void
+ScanSnapshot::computeDelta(const ScanSnapshot & previous,
+                           Delta &              delta)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("previous = ", &previous, "delta = ", &delta); //####
+    ConnectionMap newConnections;
+    ConnectionMap oldConnections;
+    
+    delta.clear();
+    compareCollections(previous._detectedServices, _detectedServices, delta._addedServices,
+                       delta._removedServices, servicesMatch);
+    compareCollections(previous._associatedPorts, _associatedPorts, delta._addedAssociates,
+                       delta._removedAssociates, associatesMatch);
+    compareCollections(previous._standalonePorts, _standalonePorts, delta._addedPorts,
+                       delta._removedPorts, portsMatch);
+    for (ConnectionList::const_iterator walker(previous._connections.begin());
+         previous._connections.end() != walker; ++walker)
+    {
+        oldConnections[makeConnectionKey(*walker)] = &*walker;
+    }
+    for (ConnectionList::const_iterator walker(_connections.begin());
+         _connections.end() != walker; ++walker)
+    {
+        newConnections[makeConnectionKey(*walker)] = &*walker;
+    }
+    for (ConnectionMap::const_iterator walker(oldConnections.begin());
+         oldConnections.end() != walker; ++walker)
+    {
+        ConnectionMap::const_iterator match(newConnections.find(walker->first));
+        
+        if ((newConnections.end() == match) || (match->second->_mode != walker->second->_mode))
+        {
+            delta._removedConnections.push_back(*walker->second);
+        }
+    }
+    for (ConnectionMap::const_iterator walker(newConnections.begin());
+         newConnections.end() != walker; ++walker)
+    {
+        ConnectionMap::const_iterator match(oldConnections.find(walker->first));
+        
+        if ((oldConnections.end() == match) || (match->second->_mode != walker->second->_mode))
+        {
+            delta._addedConnections.push_back(*walker->second);
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ScanSnapshot::computeDelta
+
+void
+ScanSnapshot::Delta::clear(void)
+{
+    ODL_ENTER(); //####
+    _addedAssociates.clear();
+    _addedConnections.clear();
+    _addedPorts.clear();
+    _addedServices.clear();
+    _removedAssociates.clear();
+    _removedConnections.clear();
+    _removedPorts.clear();
+    _removedServices.clear();
+    ODL_EXIT(); //####
+} // ScanSnapshot::Delta::clear
+
+bool
+ScanSnapshot::Delta::isEmpty(void)
+const
+{
+    ODL_ENTER(); //####
+    bool result = (_addedAssociates.empty() && _addedConnections.empty() && _addedPorts.empty() &&
+                   _addedServices.empty() && _removedAssociates.empty() &&
+                   _removedConnections.empty() && _removedPorts.empty() &&
+                   _removedServices.empty());
+    
+    ODL_EXIT_B(result); //####
+    return result;
+} // ScanSnapshot::Delta::isEmpty
+
+void
+ScanSnapshot::swap(ScanSnapshot & other)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("other = ", &other); //####
+    _detectedServices.swap(other._detectedServices);
+    _rememberedPorts.swap(other._rememberedPorts);
+    _associatedPorts.swap(other._associatedPorts);
+    _standalonePorts.swap(other._standalonePorts);
+    _connections.swap(other._connections);
+    ODL_OBJEXIT(); //####
+} // ScanSnapshot::swap
+
+void
+ScanSnapshot::writeAsJson(std::ostream & output)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("output = ", &output); //####
+    bool first = true;
+    
+    output << "{\"services\":[";
+    for (ServiceMap::const_iterator walker(_detectedServices.begin());
+         _detectedServices.end() != walker; ++walker)
+    {
+        const MplusM::Utilities::ServiceDescriptor & descriptor = walker->second;
+        
+        if (! first)
+        {
+            output << ",";
+        }
+        first = false;
+        output << "{\"name\":\"" << EscapeForJson(descriptor._serviceName.c_str()) <<
+                    "\",\"channel\":\"" << EscapeForJson(descriptor._channelName.c_str()) <<
+                    "\",\"kind\":\"" << EscapeForJson(descriptor._kind.c_str()) <<
+                    "\",\"description\":\"" << EscapeForJson(descriptor._description.c_str()) <<
+                    "\",\"inputs\":";
+        writeChannelsAsJson(output, descriptor._inputChannels);
+        output << ",\"outputs\":";
+        writeChannelsAsJson(output, descriptor._outputChannels);
+        output << "}";
+    }
+    output << "],\"adapters\":[";
+    first = true;
+    for (AssociatesMap::const_iterator walker(_associatedPorts.begin());
+         _associatedPorts.end() != walker; ++walker)
+    {
+        const PortAndAssociates & associates = walker->second;
+        
+        if (! first)
+        {
+            output << ",";
+        }
+        first = false;
+        output << "{\"address\":\"" << EscapeForJson(walker->first) << "\",\"name\":\"" <<
+                    EscapeForJson(associates._name) << "\",\"inputs\":";
+        writeNamesAsJson(output, associates._associates._inputs);
+        output << ",\"outputs\":";
+        writeNamesAsJson(output, associates._associates._outputs);
+        output << "}";
+    }
+    output << "],\"ports\":[";
+    first = true;
+    for (PortMap::const_iterator walker(_standalonePorts.begin()); _standalonePorts.end() != walker;
+         ++walker)
+    {
+        if (! first)
+        {
+            output << ",";
+        }
+        first = false;
+        output << "{\"address\":\"" << EscapeForJson(walker->first) << "\",\"name\":\"" <<
+                    EscapeForJson(walker->second._name) << "\",\"direction\":\"" <<
+                    getDirectionName(walker->second._direction) << "\"}";
+    }
+    output << "],\"connections\":[";
+    for (ConnectionList::const_iterator walker(_connections.begin()); _connections.end() != walker;
+         ++walker)
+    {
+        if (_connections.begin() != walker)
+        {
+            output << ",";
+        }
+        output << "{\"from\":\"" << EscapeForJson(walker->_outPortName) << "\",\"to\":\"" <<
+                    EscapeForJson(walker->_inPortName) << "\",\"mode\":\"" <<
+                    getModeName(walker->_mode) << "\"}";
+    }
+    output << "]}";
+    ODL_OBJEXIT(); //####
+} // ScanSnapshot::writeAsJson
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,329 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanSnapshot.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for the results of a background scan.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ScanSnapshot__))
+# define __ServiceViewer__ScanSnapshot__  /* Header guard */
+
+# include "PortEntry.h"
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MUtilities.h>
+
+# include <map>
+# include <ostream>
+# include <set>
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for the results of a background scan. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief The results of a background scan.
+ 
+ The results of two scans can be compared, so that only the entities and connections that have
+ changed need to be updated in the display. */
+class ScanSnapshot
+{
+public :
+    
+    /*! @brief The information for a connection. */
+    struct ConnectionDetails
+    {
+        /*! @brief The name of the destination port. */
+        string _inPortName;
+        
+        /*! @brief The name of the source port. */
+        string _outPortName;
+        
+        /*! @brief The mode of the connection. */
+        MplusM::Common::ChannelMode _mode;
+        
+    }; // ConnectionDetails
+    
+    /*! @brief The name and direction for a port. */
+    struct NameAndDirection
+    {
+        /*! @brief The name of the port. */
+        string _name;
+        
+        /*! @brief The direction of the port. */
+        PortEntry::PortDirection _direction;
+        
+    }; // NameAndDirection
+    
+    /*! @brief The name and associates for a port. */
+    struct PortAndAssociates
+    {
+        /*! @brief The name of the port. */
+        string _name;
+        
+        /*! @brief The associates of the port. */
+        MplusM::Utilities::PortAssociation _associates;
+        
+    }; // PortAndAssociates
+    
+    /*! @brief A mapping from port names to associates. */
+    typedef std::map<string, PortAndAssociates> AssociatesMap;
+    
+    /*! @brief A collection of connections. */
+    typedef std::vector<ConnectionDetails> ConnectionList;
+    
+    /*! @brief A collection of keys. */
+    typedef std::vector<string> KeyList;
+    
+    /*! @brief A collection of port names. */
+    typedef std::map<string, NameAndDirection> PortMap;
+    
+    /*! @brief A collection of port names. */
+    typedef std::set<string> PortSet;
+    
+    /*! @brief A mapping from strings to service descriptions. */
+    typedef std::map<string, MplusM::Utilities::ServiceDescriptor> ServiceMap;
+    
+    /*! @brief The differences between two scans. Added entries refer to the newer scan and
+     removed entries refer to the older scan; an entry that has changed is both removed and
+     added. */
+    struct Delta
+    {
+        /*! @brief The keys for the associated ports that have appeared. */
+        KeyList _addedAssociates;
+        
+        /*! @brief The connections that have appeared. */
+        ConnectionList _addedConnections;
+        
+        /*! @brief The keys for the standalone ports that have appeared. */
+        KeyList _addedPorts;
+        
+        /*! @brief The keys for the services that have appeared. */
+        KeyList _addedServices;
+        
+        /*! @brief The keys for the associated ports that have vanished. */
+        KeyList _removedAssociates;
+        
+        /*! @brief The connections that have vanished. */
+        ConnectionList _removedConnections;
+        
+        /*! @brief The keys for the standalone ports that have vanished. */
+        KeyList _removedPorts;
+        
+        /*! @brief The keys for the services that have vanished. */
+        KeyList _removedServices;
+        
+        /*! @brief Remove all the differences. */
+        void
+        clear(void);
+        
+        /*! @brief Returns @c true if there are no differences and @c false otherwise.
+         @returns @c true if there are no differences and @c false otherwise. */
+        bool
+        isEmpty(void)
+        const;
+        
+    }; // Delta
+    
+    /*! @brief The constructor. */
+    ScanSnapshot(void);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ScanSnapshot(void);
+    
+    /*! @brief Replace the contents of this scan with a copy of another scan.
+     @param other The scan to be copied. */
+    void
+    assign(const ScanSnapshot & other);
+    
+    /*! @brief Remove all the scan results. */
+    void
+    clear(void);
+    
+    /*! @brief Determine the differences between an older scan and this scan.
+     @param previous The older scan.
+     @param delta The differences between the scans. */
+    void
+    computeDelta(const ScanSnapshot & previous,
+                 Delta &              delta)
+    const;
+    
+    /*! @brief Return the set of ports with associates.
+     @returns The set of ports with associates. */
+    inline AssociatesMap &
+    getAssociates(void)
+    {
+        return _associatedPorts;
+    } // getAssociates
+    
+    /*! @brief Return the set of ports with associates.
+     @returns The set of ports with associates. */
+    inline const AssociatesMap &
+    getAssociates(void)
+    const
+    {
+        return _associatedPorts;
+    } // getAssociates
+    
+    /*! @brief Return the set of connections.
+     @returns The set of connections. */
+    inline ConnectionList &
+    getConnections(void)
+    {
+        return _connections;
+    } // getConnections
+    
+    /*! @brief Return the set of connections.
+     @returns The set of connections. */
+    inline const ConnectionList &
+    getConnections(void)
+    const
+    {
+        return _connections;
+    } // getConnections
+    
+    /*! @brief Return the set of known ports.
+     @returns The set of known ports. */
+    inline PortSet &
+    getRememberedPorts(void)
+    {
+        return _rememberedPorts;
+    } // getRememberedPorts
+    
+    /*! @brief Return the set of known ports.
+     @returns The set of known ports. */
+    inline const PortSet &
+    getRememberedPorts(void)
+    const
+    {
+        return _rememberedPorts;
+    } // getRememberedPorts
+    
+    /*! @brief Return the set of services.
+     @returns The set of services. */
+    inline ServiceMap &
+    getServices(void)
+    {
+        return _detectedServices;
+    } // getServices
+    
+    /*! @brief Return the set of services.
+     @returns The set of services. */
+    inline const ServiceMap &
+    getServices(void)
+    const
+    {
+        return _detectedServices;
+    } // getServices
+    
+    /*! @brief Return the set of standalone ports.
+     @returns The set of standalone ports. */
+    inline PortMap &
+    getStandalonePorts(void)
+    {
+        return _standalonePorts;
+    } // getStandalonePorts
+    
+    /*! @brief Return the set of standalone ports.
+     @returns The set of standalone ports. */
+    inline const PortMap &
+    getStandalonePorts(void)
+    const
+    {
+        return _standalonePorts;
+    } // getStandalonePorts
+    
+    /*! @brief Exchange the contents of this scan with another scan.
+     @param other The scan to exchange with. */
+    void
+    swap(ScanSnapshot & other);
+    
+    /*! @brief Write the contents of this scan as a single-line JSON object.
+     @param output The stream to write to. */
+    void
+    writeAsJson(std::ostream & output)
+    const;
+    
+    /*! @brief Return the name of a port direction, for output.
+     @param direction The port direction.
+     @returns The name of the port direction. */
+    static const char *
+    getDirectionName(const PortEntry::PortDirection direction);
+    
+    /*! @brief Return the name of a connection mode, for output.
+     @param mode The connection mode.
+     @returns The name of the connection mode. */
+    static const char *
+    getModeName(const MplusM::Common::ChannelMode mode);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(ScanSnapshot);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief A set of known services. */
+    ServiceMap _detectedServices;
+    
+    /*! @brief A set of known ports. */
+    PortSet _rememberedPorts;
+    
+    /*! @brief A set of associated ports. */
+    AssociatesMap _associatedPorts;
+    
+    /*! @brief A set of standalone ports. */
+    PortMap _standalonePorts;
+    
+    /*! @brief A set of connections. */
+    ConnectionList _connections;
+    
+}; // ScanSnapshot
+
+#endif // ! defined(__ServiceViewer__ScanSnapshot__)
@@ -0,0 +1,138 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanSnapshotBuffer.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for a triple buffer of scan results.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ScanSnapshotBuffer.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include <algorithm>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for a triple buffer of scan results. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScanSnapshotBuffer::ScanSnapshotBuffer(void) :
+    _indexLock(), _writeIndex(0), _readyIndex(1), _readIndex(2), _fresh(false)
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // ScanSnapshotBuffer::ScanSnapshotBuffer
+
+ScanSnapshotBuffer::~ScanSnapshotBuffer(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ScanSnapshotBuffer::~ScanSnapshotBuffer
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ScanSnapshotBuffer::clear(void)
+{
+    ODL_OBJENTER(); //####
+    _indexLock.lock();
+    for (size_t ii = 0; kSnapshotCount > ii; ++ii)
+    {
+        _snapshots[ii].clear();
+    }
+    _fresh = false;
+    _indexLock.unlock();
+    ODL_OBJEXIT(); //####
+} // ScanSnapshotBuffer::clear
+
+void
+ScanSnapshotBuffer::publish(void)
+{
+    ODL_OBJENTER(); //####
+    _indexLock.lock();
+    std::swap(_writeIndex, _readyIndex);
+    _fresh = true;
+    _indexLock.unlock();
+    // The scanner starts the next pass from an empty snapshot.
+    _snapshots[_writeIndex].clear();
+    ODL_OBJEXIT(); //####
+} // ScanSnapshotBuffer::publish
+
+bool
+ScanSnapshotBuffer::takeLatest(void)
+{
+    ODL_OBJENTER(); //####
+    bool result;
+    
+    _indexLock.lock();
+    result = _fresh;
+    if (_fresh)
+    {
+        std::swap(_readIndex, _readyIndex);
+        _fresh = false;
+    }
+    _indexLock.unlock();
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ScanSnapshotBuffer::takeLatest
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,149 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanSnapshotBuffer.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for a triple buffer of scan results.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ScanSnapshotBuffer__))
+# define __ServiceViewer__ScanSnapshotBuffer__  /* Header guard */
+
+# include "ScanSnapshot.h"
+
+# include "ofTypes.h"
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for a triple buffer of scan results. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief A triple buffer of scan results.
+ 
+ The scanner fills the 'write' snapshot and publishes it, while the display works from the 'read'
+ snapshot. Publishing and taking a snapshot only exchange slot indices, so neither side waits for
+ the other to finish with its snapshot; a snapshot that is published before the previous one was
+ taken simply replaces it. */
+class ScanSnapshotBuffer
+{
+public :
+    
+    /*! @brief The constructor. */
+    ScanSnapshotBuffer(void);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ScanSnapshotBuffer(void);
+    
+    /*! @brief Clear out all the snapshots. */
+    void
+    clear(void);
+    
+    /*! @brief Return the snapshot most recently taken by the display.
+     @returns The snapshot most recently taken by the display. */
+    inline ScanSnapshot &
+    getReadSnapshot(void)
+    {
+        return _snapshots[_readIndex];
+    } // getReadSnapshot
+    
+    /*! @brief Return the snapshot being filled by the scanner.
+     @returns The snapshot being filled by the scanner. */
+    inline ScanSnapshot &
+    getWriteSnapshot(void)
+    {
+        return _snapshots[_writeIndex];
+    } // getWriteSnapshot
+    
+    /*! @brief Make the snapshot filled by the scanner available to the display. */
+    void
+    publish(void);
+    
+    /*! @brief Make the most recently published snapshot the 'read' snapshot.
+     @returns @c true if a snapshot was published since the last call and @c false otherwise. */
+    bool
+    takeLatest(void);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(ScanSnapshotBuffer);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The number of snapshots in the buffer. */
+    static const size_t kSnapshotCount = 3;
+    
+    /*! @brief The snapshots. */
+    ScanSnapshot _snapshots[kSnapshotCount];
+    
+    /*! @brief Control access to the slot indices. */
+    ofMutex _indexLock;
+    
+    /*! @brief The index of the snapshot being filled by the scanner. */
+    size_t _writeIndex;
+    
+    /*! @brief The index of the most recently published snapshot. */
+    size_t _readyIndex;
+    
+    /*! @brief The index of the snapshot being used by the display. */
+    size_t _readIndex;
+    
+    /*! @brief @c true if a snapshot was published and not yet taken and @c false otherwise. */
+    bool _fresh;
+    
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+    /*! @brief Filler to pad to alignment boundary */
+    char _filler[7];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+    
+}; // ScanSnapshotBuffer
+
+#endif // ! defined(__ServiceViewer__ScanSnapshotBuffer__)
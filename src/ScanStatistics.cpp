@@ -0,0 +1,434 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanStatistics.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for the timing of scans and their requests.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ScanStatistics.h"
+#include "Utilities.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for the timing of scans and their requests. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The names of the kinds of measurement, in the same order as the Measurement values. */
+static const char * kMeasurementNames[] =
+{
+    "wholeScan",
+    "connectionsScan",
+    "removeStalePorts",
+    "detectPorts",
+    "serviceNames",
+    "services",
+    "associates",
+    "standalonePorts",
+    "directionProbing",
+    "connections",
+    "descriptorRequest",
+    "associatesRequest",
+    "directionRequest",
+    "connectionsRequest",
+    "applyScan",
+    "layout"
+};
+
+/*! @brief The number of services or ports that are kept for each kind of request. */
+static const size_t kMaxTargets = 100;
+
+/*! @brief The number of slowest services or ports that are shown for each kind of request. */
+static const size_t kSlowestShown = 3;
+
+/*! @brief The number of slowest services or ports that are saved for each kind of request. */
+static const size_t kSlowestSaved = 20;
+
+/*! @brief A service or port name and the mean time of its requests. */
+typedef std::pair<unsigned long long, string> TargetAndMean;
+
+/*! @brief A collection of service or port names and the mean times of their requests. */
+typedef std::vector<TargetAndMean> TargetAndMeanList;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return the histogram bucket for a measurement.
+ @param elapsed The measurement, in microseconds.
+ @param bucketCount The number of buckets in the histogram.
+ @returns The histogram bucket for the measurement. */
+static int
+bucketForTime(const unsigned long long elapsed,
+              const int                bucketCount)
+{
+    int result = 0;
+    
+    for (unsigned long long limit = 2; (limit <= elapsed) && ((bucketCount - 1) > result);
+         limit <<= 1)
+    {
+        ++result;
+    }
+    return result;
+} // bucketForTime
+
+/*! @brief Return a time in microseconds as milliseconds, for display.
+ @param elapsed The time, in microseconds.
+ @returns The time in milliseconds, as a string. */
+static string
+formatMilliseconds(const unsigned long long elapsed)
+{
+    std::ostringstream result;
+    
+    result << std::fixed << std::setprecision(1) << (elapsed / 1000.0);
+    return result.str();
+} // formatMilliseconds
+
+/*! @brief Compare two mean times, so that the longest is first.
+ @param first The first mean time.
+ @param second The second mean time.
+ @returns @c true if the first mean time is longer than the second and @c false otherwise. */
+static bool
+longestFirst(const TargetAndMean & first,
+             const TargetAndMean & second)
+{
+    return (first.first > second.first);
+} // longestFirst
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+unsigned long long
+ScanStatistics::getTime(void)
+{
+    return ofGetElapsedTimeMicros();
+} // ScanStatistics::getTime
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScanStatistics::ScanStatistics(void) :
+    _lock()
+{
+    ODL_ENTER(); //####
+    memset(_histograms, 0, sizeof(_histograms));
+    ODL_EXIT_P(this); //####
+} // ScanStatistics::ScanStatistics
+
+ScanStatistics::~ScanStatistics(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ScanStatistics::~ScanStatistics
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ScanStatistics::addToHistogram(const Measurement        which,
+                               const unsigned long long elapsed)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("which = ", which); //####
+    ODL_L1("elapsed = ", elapsed); //####
+    Histogram & aHistogram = _histograms[which];
+    
+    ++aHistogram._count;
+    aHistogram._total += elapsed;
+    aHistogram._last = elapsed;
+    aHistogram._maximum = std::max(aHistogram._maximum, elapsed);
+    ++aHistogram._buckets[bucketForTime(elapsed, kBucketCount)];
+    ODL_OBJEXIT(); //####
+} // ScanStatistics::addToHistogram
+
+void
+ScanStatistics::dropFastestTarget(const Measurement which)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("which = ", which); //####
+    TargetMap &         targets = _targets[which];
+    TargetMap::iterator fastest(targets.end());
+    unsigned long long  fastestMean = 0;
+    
+    for (TargetMap::iterator walker(targets.begin()); targets.end() != walker; ++walker)
+    {
+        unsigned long long mean = walker->second._total / walker->second._count;
+        
+        if ((targets.end() == fastest) || (fastestMean > mean))
+        {
+            fastest = walker;
+            fastestMean = mean;
+        }
+    }
+    if (targets.end() != fastest)
+    {
+        SlowestList & slowest = _slowest[which];
+        
+        for (SlowestList::iterator walker(slowest.begin()); slowest.end() != walker; ++walker)
+        {
+            if (fastest->first == walker->second)
+            {
+                slowest.erase(walker);
+                break;
+            }
+        }
+        targets.erase(fastest);
+    }
+    ODL_OBJEXIT(); //####
+} // ScanStatistics::dropFastestTarget
+
+void
+ScanStatistics::describe(std::vector<string> & lines)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("lines = ", &lines); //####
+    lines.clear();
+    _lock.lock();
+    for (int ii = 0; kMeasurementCount > ii; ++ii)
+    {
+        const Histogram & aHistogram = _histograms[ii];
+        
+        if (0 < aHistogram._count)
+        {
+            std::ostringstream aLine;
+            
+            aLine << kMeasurementNames[ii] << ": " << aHistogram._count << " x, last " <<
+                    formatMilliseconds(aHistogram._last) << " ms, mean " <<
+                    formatMilliseconds(aHistogram._total / aHistogram._count) << " ms, max " <<
+                    formatMilliseconds(aHistogram._maximum) << " ms";
+            lines.push_back(aLine.str());
+            // The slowest services or ports are kept in order as they are measured.
+            for (SlowestList::const_iterator walker(_slowest[ii].begin());
+                 _slowest[ii].end() != walker; ++walker)
+            {
+                lines.push_back("    " + walker->second + ": mean " +
+                                formatMilliseconds(walker->first) + " ms");
+            }
+        }
+    }
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // ScanStatistics::describe
+
+void
+ScanStatistics::record(const Measurement        which,
+                       const unsigned long long startTime)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("which = ", which); //####
+    ODL_L1("startTime = ", startTime); //####
+    unsigned long long elapsed = getTime() - startTime;
+    
+    _lock.lock();
+    addToHistogram(which, elapsed);
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // ScanStatistics::record
+
+void
+ScanStatistics::record(const Measurement        which,
+                       const unsigned long long startTime,
+                       const string &           target)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("which = ", which); //####
+    ODL_L1("startTime = ", startTime); //####
+    ODL_S1s("target = ", target); //####
+    unsigned long long elapsed = getTime() - startTime;
+    unsigned long long mean;
+    
+    _lock.lock();
+    addToHistogram(which, elapsed);
+    TargetMap::iterator match(_targets[which].find(target));
+    
+    if (_targets[which].end() == match)
+    {
+        Timing newTiming;
+        
+        // Client ports have generated names, so the number of services and ports that are kept
+        // is limited.
+        if (kMaxTargets <= _targets[which].size())
+        {
+            dropFastestTarget(which);
+        }
+        newTiming._count = 1;
+        newTiming._total = newTiming._last = newTiming._maximum = elapsed;
+        _targets[which].insert(TargetMap::value_type(target, newTiming));
+        mean = elapsed;
+    }
+    else
+    {
+        Timing & aTiming = match->second;
+        
+        ++aTiming._count;
+        aTiming._total += elapsed;
+        aTiming._last = elapsed;
+        aTiming._maximum = std::max(aTiming._maximum, elapsed);
+        mean = aTiming._total / aTiming._count;
+    }
+    updateSlowest(which, target, mean);
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // ScanStatistics::record
+
+bool
+ScanStatistics::save(const string & filePath)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("filePath = ", filePath); //####
+    bool               result = false;
+    std::ostringstream output;
+    
+    _lock.lock();
+    output << "{\"time\":" << ofGetUnixTime() << ",\"measurements\":{";
+    for (int ii = 0; kMeasurementCount > ii; ++ii)
+    {
+        const Histogram & aHistogram = _histograms[ii];
+        
+        if (0 < ii)
+        {
+            output << ",";
+        }
+        output << "\"" << kMeasurementNames[ii] << "\":{\"count\":" << aHistogram._count <<
+                    ",\"totalMicros\":" << aHistogram._total << ",\"lastMicros\":" <<
+                    aHistogram._last << ",\"maxMicros\":" << aHistogram._maximum <<
+                    ",\"buckets\":[";
+        for (int jj = 0; kBucketCount > jj; ++jj)
+        {
+            output << ((0 < jj) ? "," : "") << aHistogram._buckets[jj];
+        }
+        output << "]";
+        if (! _targets[ii].empty())
+        {
+            TargetAndMeanList slowest;
+            
+            for (TargetMap::const_iterator walker(_targets[ii].begin());
+                 _targets[ii].end() != walker; ++walker)
+            {
+                slowest.push_back(TargetAndMean(walker->second._total / walker->second._count,
+                                                walker->first));
+            }
+            std::sort(slowest.begin(), slowest.end(), longestFirst);
+            output << ",\"slowest\":[";
+            for (size_t jj = 0, mm = std::min(slowest.size(), kSlowestSaved); mm > jj; ++jj)
+            {
+                const Timing & aTiming = _targets[ii][slowest[jj].second];
+                
+                output << ((0 < jj) ? "," : "") << "{\"name\":\"" <<
+                            EscapeForJson(slowest[jj].second) << "\",\"count\":" <<
+                            aTiming._count << ",\"meanMicros\":" << slowest[jj].first <<
+                            ",\"lastMicros\":" << aTiming._last << ",\"maxMicros\":" <<
+                            aTiming._maximum << "}";
+            }
+            output << "]";
+        }
+        output << "}";
+    }
+    output << "}}";
+    _lock.unlock();
+    // The file is replaced in one step, so that a reader never sees a partial file.
+    string        tempPath(filePath + ".tmp");
+    std::ofstream outFile(tempPath.c_str());
+    
+    if (outFile)
+    {
+        outFile << output.str() << std::endl;
+        outFile.close();
+#if (! MAC_OR_LINUX_)
+        std::remove(filePath.c_str());
+#endif // ! MAC_OR_LINUX_
+        result = (! outFile.fail()) && (0 == std::rename(tempPath.c_str(), filePath.c_str()));
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ScanStatistics::save
+
+void
+ScanStatistics::updateSlowest(const Measurement        which,
+                              const string &           target,
+                              const unsigned long long mean)
+{
+    ODL_OBJENTER(); //####
+    ODL_L1("which = ", which); //####
+    ODL_S1s("target = ", target); //####
+    ODL_L1("mean = ", mean); //####
+    SlowestList & slowest = _slowest[which];
+    
+    for (SlowestList::iterator walker(slowest.begin()); slowest.end() != walker; ++walker)
+    {
+        if (target == walker->second)
+        {
+            slowest.erase(walker);
+            break;
+        }
+    }
+    TargetAndMean newEntry(mean, target);
+    
+    slowest.insert(std::upper_bound(slowest.begin(), slowest.end(), newEntry, longestFirst),
+                   newEntry);
+    if (kSlowestShown < slowest.size())
+    {
+        slowest.resize(kSlowestShown);
+    }
+    ODL_OBJEXIT(); //####
+} // ScanStatistics::updateSlowest
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
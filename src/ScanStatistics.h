@@ -0,0 +1,261 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanStatistics.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for the timing of scans and their requests.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ScanStatistics__))
+# define __ServiceViewer__ScanStatistics__  /* Header guard */
+
+# include "ofTypes.h"
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MCommon.h>
+
+# include <map>
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for the timing of scans and their requests. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief The timing of scans and their requests.
+ 
+ Each kind of measurement keeps a count, the total, last and largest times and a histogram with
+ power-of-two buckets, in microseconds. The measurements of individual requests are also kept per
+ service or port, so that the slow ones can be found; since client ports have generated names, only
+ a limited number of services or ports are kept, with the fastest making room for new ones. The
+ slowest few are kept in order as they are measured, for display. The measurements are made from
+ several threads, so all access is serialized. */
+class ScanStatistics
+{
+public :
+    
+    /*! @brief The kinds of measurement. */
+    enum Measurement
+    {
+        /*! @brief A complete scan. */
+        kMeasurementWholeScan,
+        
+        /*! @brief A check of the connections between the known ports. */
+        kMeasurementConnectionsScan,
+        
+        /*! @brief Removing stale ports from the name server. */
+        kMeasurementRemoveStalePorts,
+        
+        /*! @brief Retrieving the list of ports from the name server. */
+        kMeasurementDetectPorts,
+        
+        /*! @brief Retrieving the list of services. */
+        kMeasurementServiceNames,
+        
+        /*! @brief Retrieving the descriptions of all the services. */
+        kMeasurementServices,
+        
+        /*! @brief Retrieving the associates of all the ports. */
+        kMeasurementAssociates,
+        
+        /*! @brief Recording all the standalone ports, including determining their directions. */
+        kMeasurementStandalonePorts,
+        
+        /*! @brief Determining the directions of all the standalone ports. */
+        kMeasurementDirectionProbing,
+        
+        /*! @brief Retrieving the connections of all the ports. */
+        kMeasurementConnections,
+        
+        /*! @brief Retrieving the description of one service. */
+        kMeasurementDescriptorRequest,
+        
+        /*! @brief Retrieving the associates of one port. */
+        kMeasurementAssociatesRequest,
+        
+        /*! @brief Determining the direction of one port. */
+        kMeasurementDirectionRequest,
+        
+        /*! @brief Retrieving the connections of one port. */
+        kMeasurementConnectionsRequest,
+        
+        /*! @brief Updating the displayed entities from a scan. */
+        kMeasurementApplyScan,
+        
+        /*! @brief Calculating the positions of the entities. */
+        kMeasurementLayout,
+        
+        /*! @brief The number of kinds of measurement. */
+        kMeasurementCount
+        
+    }; // Measurement
+    
+    /*! @brief The constructor. */
+    ScanStatistics(void);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ScanStatistics(void);
+    
+    /*! @brief Return a summary of the measurements, for display.
+     @param lines The summary, as a set of lines. */
+    void
+    describe(std::vector<string> & lines);
+    
+    /*! @brief Record a measurement.
+     @param which The kind of measurement.
+     @param startTime When the measured activity began, as returned by getTime(). */
+    void
+    record(const Measurement        which,
+           const unsigned long long startTime);
+    
+    /*! @brief Record a measurement of a request to a service or port.
+     @param which The kind of measurement.
+     @param startTime When the request began, as returned by getTime().
+     @param target The name of the service or port. */
+    void
+    record(const Measurement        which,
+           const unsigned long long startTime,
+           const string &           target);
+    
+    /*! @brief Write the measurements to a file as a JSON object, replacing the file.
+     @param filePath The path to the file.
+     @returns @c true if the measurements were written and @c false otherwise. */
+    bool
+    save(const string & filePath);
+    
+    /*! @brief Return the current time, for measuring.
+     @returns The current time, in microseconds. */
+    static unsigned long long
+    getTime(void);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(ScanStatistics);
+    
+    /*! @brief The size of a histogram. */
+    enum
+    {
+        /*! @brief The number of buckets in a histogram; the last bucket also holds everything
+         longer than about 8 seconds. */
+        kBucketCount = 24
+        
+    }; // anonymous
+    
+    /*! @brief The timing of one kind of activity. */
+    struct Timing
+    {
+        /*! @brief The number of measurements. */
+        unsigned long _count;
+        
+        /*! @brief The sum of the measurements, in microseconds. */
+        unsigned long long _total;
+        
+        /*! @brief The most recent measurement, in microseconds. */
+        unsigned long long _last;
+        
+        /*! @brief The largest measurement, in microseconds. */
+        unsigned long long _maximum;
+        
+    }; // Timing
+    
+    /*! @brief The timing of one kind of measurement, with a histogram. */
+    struct Histogram : public Timing
+    {
+        /*! @brief The number of measurements in each bucket, where bucket N holds those shorter
+         than 2 to the power N + 1 microseconds. */
+        unsigned long _buckets[kBucketCount];
+        
+    }; // Histogram
+    
+    /*! @brief A mapping from service or port names to their request timings. */
+    typedef std::map<string, Timing> TargetMap;
+    
+    /*! @brief The mean request times and names of the slowest services or ports, slowest
+     first. */
+    typedef std::vector<std::pair<unsigned long long, string> > SlowestList;
+    
+    /*! @brief Add a measurement to the histogram for a kind of measurement.
+     @param which The kind of measurement.
+     @param elapsed The measurement, in microseconds. */
+    void
+    addToHistogram(const Measurement        which,
+                   const unsigned long long elapsed);
+    
+    /*! @brief Forget the service or port with the shortest mean request time for a kind of
+     measurement.
+     @param which The kind of measurement. */
+    void
+    dropFastestTarget(const Measurement which);
+    
+    /*! @brief Update the slowest services or ports for a kind of measurement.
+     @param which The kind of measurement.
+     @param target The name of the service or port that was measured.
+     @param mean The mean request time of the service or port, in microseconds. */
+    void
+    updateSlowest(const Measurement        which,
+                  const string &           target,
+                  const unsigned long long mean);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The timing for each kind of measurement. */
+    Histogram _histograms[kMeasurementCount];
+    
+    /*! @brief The timing of the requests to each service or port, for each kind of
+     measurement. */
+    TargetMap _targets[kMeasurementCount];
+    
+    /*! @brief The slowest services or ports, for each kind of measurement. */
+    SlowestList _slowest[kMeasurementCount];
+    
+    /*! @brief Control access to the measurements. */
+    ofMutex _lock;
+    
+}; // ScanStatistics
+
+#endif // ! defined(__ServiceViewer__ScanStatistics__)
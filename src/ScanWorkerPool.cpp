@@ -0,0 +1,279 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanWorkerPool.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for a pool of threads to issue scan requests concurrently.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ScanWorkerPool.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for a pool of threads to issue scan requests concurrently. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+bool
+ScanWorkerPool::Task::CheckForExpiry(void * stuff)
+{
+    ODL_ENTER(); //####
+    ODL_P1("stuff = ", stuff); //####
+    Task * aTask = reinterpret_cast<Task *> (stuff);
+    bool   result = ((! aTask) || aTask->isExpired());
+    
+    ODL_EXIT_B(result); //####
+    return result;
+} // ScanWorkerPool::Task::CheckForExpiry
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ScanWorkerPool::Task::Task(void) :
+    _checker(NULL), _checkStuff(NULL), _deadline(0)
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // ScanWorkerPool::Task::Task
+
+ScanWorkerPool::Task::~Task(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ScanWorkerPool::Task::~Task
+
+ScanWorkerPool::Worker::Worker(ScanWorkerPool & owner) :
+    inherited(), _owner(owner)
+{
+    ODL_ENTER(); //####
+    ODL_P1("owner = ", &owner); //####
+    ODL_EXIT_P(this); //####
+} // ScanWorkerPool::Worker::Worker
+
+ScanWorkerPool::Worker::~Worker(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ScanWorkerPool::Worker::~Worker
+
+ScanWorkerPool::ScanWorkerPool(const size_t workerCount,
+                               const float  requestDuration) :
+    _workers(), _lock(), _tasks(NULL), _checker(NULL), _checkStuff(NULL), _nextTask(0),
+    _requestDuration(requestDuration)
+{
+    ODL_ENTER(); //####
+    ODL_L1("workerCount = ", workerCount); //####
+    ODL_D1("requestDuration = ", requestDuration); //####
+    for (size_t ii = 0; workerCount > ii; ++ii)
+    {
+        _workers.push_back(new Worker(*this));
+    }
+    ODL_EXIT_P(this); //####
+} // ScanWorkerPool::ScanWorkerPool
+
+ScanWorkerPool::~ScanWorkerPool(void)
+{
+    ODL_OBJENTER(); //####
+    shutDown();
+    ODL_OBJEXIT(); //####
+} // ScanWorkerPool::~ScanWorkerPool
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+
+bool
+ScanWorkerPool::Task::isExpired(void)
+const
+{
+    ODL_OBJENTER(); //####
+    bool result = (_deadline <= ofGetElapsedTimef());
+    
+    if ((! result) && _checker)
+    {
+        result = _checker(_checkStuff);
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ScanWorkerPool::Task::isExpired
+
+void
+ScanWorkerPool::perform(TaskList &                    tasks,
+                        MplusM::Common::CheckFunction checker,
+                        void *                        checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("tasks = ", &tasks, "checkStuff = ", checkStuff); //####
+    WorkerList active;
+    
+    _lock.lock();
+    _tasks = &tasks;
+    _nextTask = 0;
+    _checker = checker;
+    _checkStuff = checkStuff;
+    _lock.unlock();
+    if (_workers.empty())
+    {
+        // Without any threads, the requests are issued one after the other.
+        while (performNextTask())
+        {
+        }
+    }
+    else
+    {
+        // Only start as many threads as there are requests to be issued.
+        for (WorkerList::const_iterator it(_workers.begin());
+             (_workers.end() != it) && (tasks.size() > active.size()); ++it)
+        {
+            Worker * aWorker = *it;
+            
+            aWorker->startThread(false, false); // non-blocking, non-verbose
+            active.push_back(aWorker);
+        }
+        for (WorkerList::const_iterator it(active.begin()); active.end() != it; ++it)
+        {
+            (*it)->waitForThread(false);
+        }
+    }
+    _lock.lock();
+    _tasks = NULL;
+    _checker = NULL;
+    _checkStuff = NULL;
+    _lock.unlock();
+    ODL_OBJEXIT(); //####
+} // ScanWorkerPool::perform
+
+bool
+ScanWorkerPool::performNextTask(void)
+{
+    ODL_OBJENTER(); //####
+    Task * aTask = NULL;
+    
+    _lock.lock();
+    if (_tasks && (_tasks->size() > _nextTask))
+    {
+        aTask = (*_tasks)[_nextTask];
+        ++_nextTask;
+    }
+    _lock.unlock();
+    if (aTask)
+    {
+        // The deadline starts when the request is taken, not when the pass started.
+        aTask->run(ofGetElapsedTimef() + _requestDuration, _checker, _checkStuff);
+    }
+    ODL_OBJEXIT_B(NULL != aTask); //####
+    return (NULL != aTask);
+} // ScanWorkerPool::performNextTask
+
+void
+ScanWorkerPool::Task::run(const float                   deadline,
+                          MplusM::Common::CheckFunction checker,
+                          void *                        checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("deadline = ", deadline); //####
+    ODL_P1("checkStuff = ", checkStuff); //####
+    _deadline = deadline;
+    _checker = checker;
+    _checkStuff = checkStuff;
+    perform(CheckForExpiry, this);
+    ODL_OBJEXIT(); //####
+} // ScanWorkerPool::Task::run
+
+void
+ScanWorkerPool::shutDown(void)
+{
+    ODL_OBJENTER(); //####
+    for (WorkerList::iterator it(_workers.begin()); _workers.end() != it; ++it)
+    {
+        Worker * aWorker = *it;
+        
+        if (aWorker)
+        {
+            if (aWorker->isThreadRunning())
+            {
+                aWorker->stopThread();
+            }
+            aWorker->waitForThread(false);
+            delete aWorker;
+        }
+    }
+    _workers.clear();
+    ODL_OBJEXIT(); //####
+} // ScanWorkerPool::shutDown
+
+void
+ScanWorkerPool::Worker::threadedFunction(void)
+{
+    ODL_OBJENTER(); //####
+    // start
+    while (isThreadRunning())
+    {
+        if (! _owner.performNextTask())
+        {
+            break;
+        }
+        
+    }
+    // done
+    ODL_OBJEXIT(); //####
+} // ScanWorkerPool::Worker::threadedFunction
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
@@ -0,0 +1,262 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ScanWorkerPool.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for a pool of threads to issue scan requests concurrently.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ScanWorkerPool__))
+# define __ServiceViewer__ScanWorkerPool__  /* Header guard */
+
+# include "ofThread.h"
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MCommon.h>
+
+# include <vector>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for a pool of threads to issue scan requests concurrently. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief A pool of threads to issue scan requests concurrently.
+ 
+ The requests of a pass are taken in order by the first idle thread, so that no more than the
+ number of threads are outstanding at any time. Each request is given its own deadline, after which
+ its early exit function reports that it is to stop, so that a service that does not respond costs
+ a single timeout rather than delaying the requests that follow it. */
+class ScanWorkerPool
+{
+public :
+    
+    /*! @brief A request to be issued by the pool. */
+    class Task
+    {
+    public :
+        
+        /*! @brief The constructor. */
+        Task(void);
+        
+        /*! @brief The destructor. */
+        virtual
+        ~Task(void);
+        
+        /*! @brief Returns @c true if the request has passed its deadline or the pass is to stop.
+         @returns @c true if the request is to stop and @c false otherwise. */
+        bool
+        isExpired(void)
+        const;
+        
+        /*! @brief Issue the request.
+         @param checker A function that provides for early exit from loops.
+         @param checkStuff The private data for the early exit function. */
+        virtual void
+        perform(MplusM::Common::CheckFunction checker,
+                void *                        checkStuff) = 0;
+        
+        /*! @brief Issue the request, with an early exit function that enforces its deadline.
+         @param deadline The time by which the request is to be completed.
+         @param checker A function that provides for early exit from loops.
+         @param checkStuff The private data for the early exit function. */
+        void
+        run(const float                   deadline,
+            MplusM::Common::CheckFunction checker,
+            void *                        checkStuff);
+        
+        /*! @brief The early exit function used for a request.
+         @param stuff The request.
+         @returns @c true if the request is to stop and @c false otherwise. */
+        static bool
+        CheckForExpiry(void * stuff);
+    
+    protected :
+
+    private :
+        
+        COPY_AND_ASSIGNMENT_(Task);
+    
+    public :
+
+    protected :
+
+    private :
+        
+        /*! @brief The function that provides for early exit from loops during the current pass. */
+        MplusM::Common::CheckFunction _checker;
+        
+        /*! @brief The private data for the early exit function during the current pass. */
+        void * _checkStuff;
+        
+        /*! @brief The time by which the request is to be completed. */
+        float _deadline;
+        
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[4];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+        
+    }; // Task
+    
+    /*! @brief A collection of requests. */
+    typedef std::vector<Task *> TaskList;
+    
+    /*! @brief The constructor.
+     @param workerCount The number of threads in the pool.
+     @param requestDuration The number of seconds allowed for each request. */
+    ScanWorkerPool(const size_t workerCount,
+                   const float  requestDuration);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ScanWorkerPool(void);
+    
+    /*! @brief Issue a set of requests, returning when all of them have completed or expired.
+     @param tasks The requests to be issued.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    void
+    perform(TaskList &                    tasks,
+            MplusM::Common::CheckFunction checker,
+            void *                        checkStuff);
+    
+    /*! @brief Issue the next request of the current pass, if there is one.
+     @returns @c true if a request was issued and @c false if there are no more requests. */
+    bool
+    performNextTask(void);
+    
+    /*! @brief Stop the threads in the pool and release them. */
+    void
+    shutDown(void);
+    
+protected :
+
+private :
+    
+    /*! @brief A thread that issues requests until there are none left. */
+    class Worker : public ofThread
+    {
+    public :
+        
+        /*! @brief The constructor.
+         @param owner The pool that manages this thread. */
+        explicit
+        Worker(ScanWorkerPool & owner);
+        
+        /*! @brief The destructor. */
+        virtual
+        ~Worker(void);
+    
+    protected :
+        
+        /*! @brief The thread run function. */
+        virtual void
+        threadedFunction(void);
+    
+    private :
+        
+        COPY_AND_ASSIGNMENT_(Worker);
+    
+    public :
+
+    protected :
+
+    private :
+        
+        /*! @brief The class that this class is derived from. */
+        typedef ofThread inherited;
+        
+        /*! @brief The pool that manages the thread. */
+        ScanWorkerPool & _owner;
+        
+    }; // Worker
+    
+    /*! @brief A collection of threads. */
+    typedef std::vector<Worker *> WorkerList;
+    
+    COPY_AND_ASSIGNMENT_(ScanWorkerPool);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The threads in the pool. */
+    WorkerList _workers;
+    
+    /*! @brief The lock used to serialize access to the requests of the current pass. */
+    ofMutex _lock;
+    
+    /*! @brief The requests of the current pass. */
+    TaskList * _tasks;
+    
+    /*! @brief The function that provides for early exit from loops during the current pass. */
+    MplusM::Common::CheckFunction _checker;
+    
+    /*! @brief The private data for the early exit function during the current pass. */
+    void * _checkStuff;
+    
+    /*! @brief The index of the next request to be issued. */
+    size_t _nextTask;
+    
+    /*! @brief The number of seconds allowed for each request. */
+    float _requestDuration;
+    
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+    /*! @brief Filler to pad to alignment boundary */
+    char _filler[4];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+    
+}; // ScanWorkerPool
+
+#endif // ! defined(__ServiceViewer__ScanWorkerPool__)
@@ -0,0 +1,166 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ServiceDescriptorCache.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for a cache of service descriptors.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "ServiceDescriptorCache.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for a cache of service descriptors. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+ServiceDescriptorCache::ServiceDescriptorCache(const float maxAge) :
+    _entries(), _maxAge(maxAge)
+{
+    ODL_ENTER(); //####
+    ODL_D1("maxAge = ", maxAge); //####
+    ODL_EXIT_P(this); //####
+} // ServiceDescriptorCache::ServiceDescriptorCache
+
+ServiceDescriptorCache::~ServiceDescriptorCache(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // ServiceDescriptorCache::~ServiceDescriptorCache
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+void
+ServiceDescriptorCache::clear(void)
+{
+    ODL_OBJENTER(); //####
+    _entries.clear();
+    ODL_OBJEXIT(); //####
+} // ServiceDescriptorCache::clear
+
+bool
+ServiceDescriptorCache::lookup(const string &                         serviceName,
+                               const string &                         serviceAddress,
+                               MplusM::Utilities::ServiceDescriptor & descriptor)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("serviceName = ", serviceName, "serviceAddress = ", serviceAddress); //####
+    ODL_P1("descriptor = ", &descriptor); //####
+    bool               result = false;
+    EntryMap::iterator match(_entries.find(serviceName));
+    
+    if (_entries.end() != match)
+    {
+        // A service at a new address is a new instance, which might not be the same as the old one.
+        if ((match->second._address == serviceAddress) &&
+            ((match->second._retrieved + _maxAge) > ofGetElapsedTimef()))
+        {
+            descriptor = match->second._descriptor;
+            result = true;
+        }
+        else
+        {
+            _entries.erase(match);
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ServiceDescriptorCache::lookup
+
+void
+ServiceDescriptorCache::remember(const string &                               serviceName,
+                                 const string &                               serviceAddress,
+                                 const MplusM::Utilities::ServiceDescriptor & descriptor)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("serviceName = ", serviceName, "serviceAddress = ", serviceAddress); //####
+    ODL_P1("descriptor = ", &descriptor); //####
+    CacheEntry & anEntry = _entries[serviceName];
+    
+    anEntry._address = serviceAddress;
+    anEntry._descriptor = descriptor;
+    anEntry._retrieved = ofGetElapsedTimef();
+    ODL_OBJEXIT(); //####
+} // ServiceDescriptorCache::remember
+
+void
+ServiceDescriptorCache::removeMissingEntries(const std::set<string> & presentServices)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("presentServices = ", &presentServices); //####
+    for (EntryMap::iterator walker(_entries.begin()); _entries.end() != walker; )
+    {
+        if (presentServices.end() == presentServices.find(walker->first))
+        {
+            _entries.erase(walker++);
+        }
+        else
+        {
+            ++walker;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceDescriptorCache::removeMissingEntries
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
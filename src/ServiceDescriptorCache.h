@@ -0,0 +1,158 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       ServiceDescriptorCache.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for a cache of service descriptors.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__ServiceDescriptorCache__))
+# define __ServiceViewer__ServiceDescriptorCache__  /* Header guard */
+
+# include "ofTypes.h"
+
+// Note that openFrameworks defines a macro called 'check' :( which messes up other header files.
+# undef check
+# include <mpm/M+MUtilities.h>
+
+# include <map>
+# include <set>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for a cache of service descriptors. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief A cache of service descriptors.
+ 
+ Retrieving the descriptor of a service requires several requests to the service, so the results
+ are kept across scans. A descriptor is retrieved again if the service reappears at a different
+ network address, since that is a different instance of the service, or if the descriptor has not
+ been retrieved for a while, in case the service was restarted at the same address. The cache is
+ only used by the background scanner, so access to it is not serialized. */
+class ServiceDescriptorCache
+{
+public :
+    
+    /*! @brief The constructor.
+     @param maxAge The number of seconds that a descriptor is used before it is retrieved again. */
+    explicit
+    ServiceDescriptorCache(const float maxAge);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~ServiceDescriptorCache(void);
+    
+    /*! @brief Remove all the entries from the cache. */
+    void
+    clear(void);
+    
+    /*! @brief Find the descriptor of a service.
+     @param serviceName The name of the service port.
+     @param serviceAddress The IP address and port number of the service port.
+     @param descriptor The descriptor of the service, if it is known.
+     @returns @c true if the descriptor of the service is known and @c false otherwise. */
+    bool
+    lookup(const string &                         serviceName,
+           const string &                         serviceAddress,
+           MplusM::Utilities::ServiceDescriptor & descriptor);
+    
+    /*! @brief Record the descriptor of a service.
+     @param serviceName The name of the service port.
+     @param serviceAddress The IP address and port number of the service port.
+     @param descriptor The descriptor of the service. */
+    void
+    remember(const string &                               serviceName,
+             const string &                               serviceAddress,
+             const MplusM::Utilities::ServiceDescriptor & descriptor);
+    
+    /*! @brief Remove the entries for services that are no longer present.
+     @param presentServices The names of the service ports that are present. */
+    void
+    removeMissingEntries(const std::set<string> & presentServices);
+    
+protected :
+
+private :
+    
+    COPY_AND_ASSIGNMENT_(ServiceDescriptorCache);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The information recorded for a service. */
+    struct CacheEntry
+    {
+        /*! @brief The IP address and port number of the service port. */
+        string _address;
+        
+        /*! @brief The descriptor of the service. */
+        MplusM::Utilities::ServiceDescriptor _descriptor;
+        
+        /*! @brief The time, in seconds, when the descriptor was retrieved. */
+        float _retrieved;
+        
+    }; // CacheEntry
+    
+    /*! @brief A mapping from service port names to cache entries. */
+    typedef std::map<string, CacheEntry> EntryMap;
+    
+    /*! @brief The known service descriptors. */
+    EntryMap _entries;
+    
+    /*! @brief The number of seconds that a descriptor is used before it is retrieved again. */
+    float _maxAge;
+    
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+    /*! @brief Filler to pad to alignment boundary */
+    char _filler[4];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+    
+}; // ServiceDescriptorCache
+
+#endif // ! defined(__ServiceViewer__ServiceDescriptorCache__)
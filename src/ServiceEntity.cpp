@@ -65,10 +65,42 @@
 /*! @brief The width and height of the marker displayed during movement. */
 static const float kMarkerSide = 12;
 
+/*! @brief The width of the outline of a selected entity, when it is displayed as a single box. */
+static const float kOverviewOutlineWidth = 2;
+
 #if defined(__APPLE__)
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
+/*! @brief Return the colour to use for an entity that is displayed as a single box.
+ @param kind The kind of entity.
+ @returns The colour to use for the entity. */
+static ofColor
+getOverviewColor(const PortPanel::EntityKind kind)
+{
+    ODL_ENTER(); //####
+    ODL_L1("kind = ", static_cast<int> (kind)); //####
+    ofColor result;
+    
+    switch (kind)
+    {
+        case PortPanel::kEntityKindClientOrAdapter :
+            result = ofColor::darkCyan;
+            break;
+        
+        case PortPanel::kEntityKindService :
+            result = ofColor::darkSlateBlue;
+            break;
+        
+        default :
+            result = ofColor::dimGray;
+            break;
+        
+    }
+    ODL_EXIT(); //####
+    return result;
+} // getOverviewColor
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -81,7 +113,7 @@ ServiceEntity::ServiceEntity(const PortPanel::EntityKind kind,
                              const string &              behaviour,
                              const string &              description,
                              ServiceViewerApp &          owner) :
-    inherited(), _panel(kind, behaviour, description, owner, *this), _node(NULL),
+    inherited(), _panel(kind, behaviour, description, owner, *this), _geometryVersion(1),
     _drawConnectMarker(false), _drawDisconnectMarker(false), _drawMoveMarker(false),
     _selected(false)
 {
@@ -102,12 +134,32 @@ ServiceEntity::~ServiceEntity(void)
 #endif // defined(__APPLE__)
 
 void
-ServiceEntity::draw(void)
+ServiceEntity::draw(const bool detailed)
 {
     ODL_OBJENTER(); //####
-    ServiceViewerApp & owner = _panel.getOwner();
-    
-    _panel.draw();
+    ODL_B1("detailed = ", detailed); //####
+    if (detailed)
+    {
+        _panel.draw();
+    }
+    else
+    {
+        // When the display is zoomed out, the names and the ports can't be read, so the panel is
+        // replaced by a box of the same size.
+        ofRectangle shape(getShape());
+        
+        ofSetColor(getOverviewColor(getKind()));
+        ofFill();
+        ofRect(shape);
+        if (_selected)
+        {
+            ofSetColor(ServiceViewerApp::getMarkerColor());
+            ofNoFill();
+            ofSetLineWidth(kOverviewOutlineWidth);
+            ofRect(shape);
+            ofSetLineWidth(1);
+        }
+    }
     if (_drawConnectMarker)
     {
         ofPoint markerPos(_panel.getWidth() / 2, _panel.getHeader());
@@ -134,78 +186,6 @@ ServiceEntity::draw(void)
         markerPos += getShape().getTopLeft() - ofPoint(kMarkerSide / 2, kMarkerSide / 2);
         ofRect(markerPos, kMarkerSide, kMarkerSide);
     }
-    for (int ii = 0, mm = _panel.getNumPorts(); mm > ii; ++ii)
-    {
-        PortEntry * anEntry = _panel.getPort(ii);
-        
-        if (anEntry)
-        {
-            ofPoint                        aCentre(anEntry->getCentre());
-            const PortEntry::Connections & connex = anEntry->getOutputConnections();
-            
-            for (PortEntry::Connections::const_iterator walker(connex.begin());
-                 connex.end() != walker; ++walker)
-            {
-                PortEntry::AnchorSide       anchorHere;
-                PortEntry::AnchorSide       anchorThere;
-                MplusM::Common::ChannelMode mode = walker->_connectionMode;
-                PortEntry *                 otherEntry = walker->_otherPort;
-                ofPoint                     otherCentre(otherEntry->getCentre());
-                ofPoint                     fromHere;
-                ofPoint                     toThere;
-                
-                // Check if the destination is above the source, in which case we
-                // determine the anchors in the reverse order.
-                if (aCentre.y < otherCentre.y)
-                {
-                    anchorHere = anEntry->calculateClosestAnchor(fromHere, true, false,
-                                                                 otherCentre);
-                    anchorThere = otherEntry->calculateClosestAnchor(toThere, false,
-                                                     PortEntry::kAnchorBottomCentre == anchorHere,
-                                                                     aCentre);
-                }
-                else
-                {
-                    anchorThere = otherEntry->calculateClosestAnchor(toThere, false, false,
-                                                                     aCentre);
-                    anchorHere = anEntry->calculateClosestAnchor(fromHere, true,
-                                                     PortEntry::kAnchorBottomCentre == anchorThere,
-                                                                 otherCentre);
-                }
-                if (otherEntry->isService())
-                {
-                    ofSetLineWidth(owner.getServiceConnectionWidth());
-                }
-                else if (otherEntry->isInputOutput())
-                {
-                    ofSetLineWidth(owner.getInputOutputConnectionWidth());
-                }
-                else
-                {
-                    ofSetLineWidth(owner.getNormalConnectionWidth());
-                }
-                switch (mode)
-                {
-                    case MplusM::Common::kChannelModeTCP :
-                        ofSetColor(ServiceViewerApp::getTcpConnectionColor());
-                        break;
-                        
-                    case MplusM::Common::kChannelModeUDP :
-                        ofSetColor(ServiceViewerApp::getUdpConnectionColor());
-                        break;
-                        
-                    default :
-                        ofSetColor(ServiceViewerApp::getOtherConnectionColor());
-                        break;
-                        
-                }
-                DrawBezier(fromHere, toThere, aCentre, otherCentre);
-                ofSetLineWidth(1);
-                PortEntry::drawSourceAnchor(anchorHere, fromHere);
-                PortEntry::drawTargetAnchor(anchorThere, toThere);
-            }
-        }
-    }
     ODL_OBJEXIT(); //####
 } // ServiceEntity::draw
 
@@ -214,32 +194,13 @@ ServiceEntity::handlePositionChange(void)
 {
     ODL_OBJENTER(); //####
     // Here we re-adjust any lines attached to the entity.
+    ++_geometryVersion;
+    _panel.getOwner().updateEntityBounds(this);
     _panel.getOwner().movementStarted();
     _selected = _drawMoveMarker = true;
     ODL_OBJEXIT(); //####
 } // ServiceEntity::handlePositionChange
 
-bool
-ServiceEntity::hasPort(const PortEntry * aPort)
-{
-    ODL_OBJENTER(); //####
-    bool result = false;
-    
-    for (int ii = 0, mm = _panel.getNumPorts(); mm > ii; ++ii)
-    {
-        PortEntry * anEntry = _panel.getPort(ii);
-        
-        if (aPort == anEntry)
-        {
-            result = true;
-            break;
-        }
-        
-    }
-    ODL_OBJEXIT_B(result); //####
-    return result;
-} // ServiceEntity::hasPort
-
 void
 ServiceEntity::positionChangeComplete(void)
 {
@@ -44,8 +44,6 @@
 
 # include "ofxGui.h"
 
-# include <ogdf/basic/Graph.h>
-
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
 #  pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -116,9 +114,11 @@ public :
         _selected = false;
     } // deselect
     
-    /*! @brief Display the entity. */
+    /*! @brief Display the entity.
+     @param detailed @c true if the ports are to be displayed and @c false if the entity is to be
+     displayed as a single box. */
     void
-    draw(void);
+    draw(const bool detailed = true);
     
     /*! @brief Returns the height of the entity.
      @returns The height of the entity. */
@@ -128,6 +128,24 @@ public :
         return _panel.getHeight();
     } // getHeight
     
+    /*! @brief Returns the kind of entity.
+     @returns The kind of entity. */
+    inline PortPanel::EntityKind
+    getKind(void)
+    const
+    {
+        return _panel.getKind();
+    } // getKind
+    
+    /*! @brief Return the number of times that the entity has been moved.
+     @returns The number of times that the entity has been moved. */
+    inline unsigned int
+    getGeometryVersion(void)
+    const
+    {
+        return _geometryVersion;
+    } // getGeometryVersion
+    
     /*! @brief Return the name of the entity.
      @returns The name of the entity. */
     inline string
@@ -136,15 +154,6 @@ public :
         return _panel.getName();
     } // getName
     
-    /*! @brief Return the node corresponding to the entity.
-     @returns The node corresponding to the entity. */
-    inline ogdf::node
-    getNode(void)
-    const
-    {
-        return _node;
-    } // getNode
-    
     /*! @brief Returns the number of ports in this entity.
      @returns The number of ports in this entity. */
     inline int
@@ -182,12 +191,6 @@ public :
     virtual void
     handlePositionChange(void);
     
-    /*! @brief Check if a port is part of the entity.
-     @param aPort The port to be checked for.
-     @returns @c true if the port is contained within the entity and @c false otherwise. */
-    bool
-    hasPort(const PortEntry * aPort);
-    
     /*! @brief Return @c true is the entity is selected.
      @returns @c true if the entity is selected and @c false otherwise. */
     inline bool
@@ -197,6 +200,42 @@ public :
         return _selected;
     } // isSelected
     
+    /*! @brief Process a mouse-dragged event.
+     @param args The attributes of the event.
+     @returns @c true if the event was processed and @c false if it can be further propagated. */
+    inline bool
+    mouseDragged(ofMouseEventArgs & args)
+    {
+        return _panel.mouseDragged(args);
+    } // mouseDragged
+    
+    /*! @brief Process a mouse-moved event.
+     @param args The attributes of the event.
+     @returns @c true if the event was processed and @c false if it can be further propagated. */
+    inline bool
+    mouseMoved(ofMouseEventArgs & args)
+    {
+        return _panel.mouseMoved(args);
+    } // mouseMoved
+    
+    /*! @brief Process a mouse-pressed event.
+     @param args The attributes of the event.
+     @returns @c true if the event was processed and @c false if it can be further propagated. */
+    inline bool
+    mousePressed(ofMouseEventArgs & args)
+    {
+        return _panel.mousePressed(args);
+    } // mousePressed
+    
+    /*! @brief Process a mouse-released event.
+     @param args The attributes of the event.
+     @returns @c true if the event was processed and @c false if it can be further propagated. */
+    inline bool
+    mouseReleased(ofMouseEventArgs & args)
+    {
+        return _panel.mouseReleased(args);
+    } // mouseReleased
+    
     /*! @brief The entity position changes are complete. */
     virtual void
     positionChangeComplete(void);
@@ -222,14 +261,6 @@ public :
         _drawDisconnectMarker = true;
     } // setDisconnectMarker
     
-    /*! @brief Sets the node corresponding to the entity.
-     @param newNode The new value for the node corresponding to the entity. */
-    inline void
-    setNode(ogdf::node newNode)
-    {
-        _node = newNode;
-    } // setNode
-    
     /*! @brief Move the entity to a new location on the display.
      @param xx The new horizontal position of the entity.
      @param yy The new vertical position of the entity. */
@@ -238,6 +269,7 @@ public :
                 const float yy = 10)
     {
         _panel.setPosition(xx, yy);
+        ++_geometryVersion;
     } // setPosition
     
     /*! @brief Set the parameters of the entity.
@@ -267,8 +299,9 @@ private :
     /*! @brief The GUI object that represents the entity. */
     PortPanel _panel;
     
-    /*! @brief The node corresponding to the entity. */
-    ogdf::node _node;
+    /*! @brief The number of times that the entity has been moved, so that cached connection
+     geometry can be checked. */
+    unsigned int _geometryVersion;
     
     /*! @brief @c true if the connect marker is to be displayed and @c false otherwise. */
     bool _drawConnectMarker;
@@ -282,16 +315,6 @@ private :
     /*! @brief @c true if the entity is selected and @c false otherwise. */
     bool _selected;
     
-# if defined(__APPLE__)
-#  pragma clang diagnostic push
-#  pragma clang diagnostic ignored "-Wunused-private-field"
-# endif // defined(__APPLE__)
-    /*! @brief Filler to pad to alignment boundary */
-    char _filler[4];
-# if defined(__APPLE__)
-#  pragma clang diagnostic pop
-# endif // defined(__APPLE__)
-    
 }; // ServiceEntity
 
 #endif // ! defined(__ServiceViewer__ServiceEntity__)
@@ -38,7 +38,14 @@
 
 #include "ServiceViewerApp.h"
 #include "BackgroundScanner.h"
+#include "BenchmarkRunner.h"
+#include "ChangeFeed.h"
+#include "LayoutWorker.h"
+#include "ScanSource.h"
+#include "ScanWorkerPool.h"
+#include "ServiceDescriptorCache.h"
 #include "ServiceEntity.h"
+#include "YarpScanSource.h"
 
 #include <odlEnable.h>
 #include <odlInclude.h>
@@ -47,9 +54,11 @@
 #include "ofBitmapFont.h"
 #include "ofGraphics.h"
 #include "ofMesh.h"
+#include "ofUtils.h"
 
-#include <ogdf/basic/GraphAttributes.h>
-#include <ogdf/energybased/FMMMLayout.h>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
 
 #if defined(__APPLE__)
 # pragma clang diagnostic push
@@ -104,9 +113,40 @@
 # pragma mark Private structures, constants and variables
 #endif // defined(__APPLE__)
 
+/*! @brief The name of the file used to hold the known port directions. */
+#define DIRECTION_CACHE_FILE "portDirections.xml"
+
+/*! @brief The name of the file used to hold the scan statistics. */
+#define STATISTICS_FILE "scanStatistics.json"
+
+/*! @brief The distance of the statistics display from the edges of the window. */
+static const float kStatisticsMargin = 20;
+
+/*! @brief The time between checks of the connections between known ports, in seconds. */
+static const float kConnectionScanInterval = 1;
+
 /*! @brief The line width for an input/output connection. */
 static const float kInputOutputConnectionWidth = 4;
 
+/*! @brief The time between checks for a request to stop, when running without a display, in
+ milliseconds. */
+static const int kHeadlessPollInterval = 100;
+
+/*! @brief The time between checks for a completed layout while benchmarking, in milliseconds. */
+static const int kBenchmarkPollInterval = 1;
+
+/*! @brief The longest time to wait for a layout while benchmarking, in seconds. */
+static const float kBenchmarkLayoutTimeout = 120;
+
+/*! @brief The minimum time between saving the scan statistics, in seconds. */
+static const float kStatisticsSaveInterval = 60;
+
+/*! @brief The time that a service descriptor is used before it is retrieved again, in seconds. */
+static const float kMaxDescriptorAge = 300;
+
+/*! @brief The maximum time between background scans, in seconds. */
+static const float kMaxScanInterval = 60;
+
 /*! @brief The minimum time between background scans, in seconds. */
 static const float kMinScanInterval = 5;
 
@@ -118,9 +158,32 @@ static const float kMinStaleInterval = 60;
 /*! @brief The line width for a normal connection. */
 static const float kNormalConnectionWidth = 2;
 
+/*! @brief The largest display scale. */
+static const float kMaxViewScale = 4;
+
+/*! @brief The smallest display scale at which the ports and the connections between them are
+ drawn; below this, each entity is drawn as a box and each pair of connected entities is joined by
+ a single line. */
+static const float kMinDetailScale = 0.5;
+
+/*! @brief The smallest display scale. */
+static const float kMinViewScale = 0.05;
+
+/*! @brief The distance that the display is moved by each arrow key press, in window pixels. */
+static const float kPanStep = 50;
+
+/*! @brief The factor by which the display scale is changed by each zoom key press. */
+static const float kViewScaleStep = 1.25;
+
 /*! @brief The line width for a normal connection. */
 static const float kServiceConnectionWidth = 6;
 
+/*! @brief The number of threads used to issue the requests of a scan concurrently. */
+static const size_t kScanWorkerCount = 8;
+
+/*! @brief The number of seconds allowed for a single request to a service or port. */
+static const float kScanRequestDuration = (2 * STANDARD_WAIT_TIME);
+
 /*! @brief @c true if the port direction resources are available. */
 static bool lPortsValid = false;
 
@@ -138,6 +201,261 @@ static yarp::os::ConstString lInputOnlyPortName;
  input. */
 static yarp::os::ConstString lOutputOnlyPortName;
 
+/*! @brief A request for the outgoing connections of a port. */
+class ConnectionsTask : public ScanWorkerPool::Task
+{
+public :
+    
+    /*! @brief The constructor.
+     @param source The network being scanned.
+     @param portName The name of the port.
+     @param statistics The timing of the scans and their requests. */
+    ConnectionsTask(ScanSource &                  source,
+                    const yarp::os::ConstString & portName,
+                    ScanStatistics &              statistics) :
+        inherited(), _outputs(), _portName(portName), _source(source), _statistics(statistics)
+    {
+    } // constructor
+    
+    /*! @brief Issue the request.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    virtual void
+    perform(MplusM::Common::CheckFunction checker,
+            void *                        checkStuff)
+    {
+        unsigned long long startTime = ScanStatistics::getTime();
+        
+        _source.gatherPortConnections(_portName, _outputs, checker, checkStuff);
+        _statistics.record(ScanStatistics::kMeasurementConnectionsRequest, startTime,
+                           _portName.c_str());
+    } // perform
+    
+    /*! @brief The ports that the port is sending to. */
+    MplusM::Common::ChannelVector _outputs;
+    
+    /*! @brief The name of the port. */
+    yarp::os::ConstString _portName;
+    
+    /*! @brief The network being scanned. */
+    ScanSource & _source;
+    
+    /*! @brief The timing of the scans and their requests. */
+    ScanStatistics & _statistics;
+    
+private :
+    
+    COPY_AND_ASSIGNMENT_(ConnectionsTask);
+    
+    /*! @brief The class that this class is derived from. */
+    typedef ScanWorkerPool::Task inherited;
+    
+}; // ConnectionsTask
+
+/*! @brief A request for the descriptor of a service. */
+class DescriptorTask : public ScanWorkerPool::Task
+{
+public :
+    
+    /*! @brief The constructor.
+     @param source The network being scanned.
+     @param serviceName The name of the service port.
+     @param serviceAddress The IP address and port number of the service port.
+     @param statistics The timing of the scans and their requests. */
+    DescriptorTask(ScanSource &                  source,
+                   const yarp::os::ConstString & serviceName,
+                   const string &                serviceAddress,
+                   ScanStatistics &              statistics) :
+        inherited(), _descriptor(), _serviceName(serviceName), _serviceAddress(serviceAddress),
+        _source(source), _statistics(statistics), _succeeded(false)
+    {
+    } // constructor
+    
+    /*! @brief Issue the request.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    virtual void
+    perform(MplusM::Common::CheckFunction checker,
+            void *                        checkStuff)
+    {
+        unsigned long long startTime = ScanStatistics::getTime();
+        
+        _succeeded = _source.getNameAndDescriptionForService(_serviceName, _descriptor, checker,
+                                                             checkStuff);
+        _statistics.record(ScanStatistics::kMeasurementDescriptorRequest, startTime,
+                           _serviceName.c_str());
+    } // perform
+    
+    /*! @brief The descriptor of the service. */
+    MplusM::Utilities::ServiceDescriptor _descriptor;
+    
+    /*! @brief The name of the service port. */
+    yarp::os::ConstString _serviceName;
+    
+    /*! @brief The IP address and port number of the service port. */
+    string _serviceAddress;
+    
+    /*! @brief The network being scanned. */
+    ScanSource & _source;
+    
+    /*! @brief The timing of the scans and their requests. */
+    ScanStatistics & _statistics;
+    
+    /*! @brief @c true if the descriptor was retrieved and @c false otherwise. */
+    bool _succeeded;
+    
+private :
+    
+    COPY_AND_ASSIGNMENT_(DescriptorTask);
+    
+    /*! @brief The class that this class is derived from. */
+    typedef ScanWorkerPool::Task inherited;
+    
+}; // DescriptorTask
+
+/*! @brief A request for the directions of a port.
+ 
+ All of the requests share the same pair of test ports, as each request connects them to a
+ different port. */
+class DirectionTask : public ScanWorkerPool::Task
+{
+public :
+    
+    /*! @brief The constructor.
+     @param portName The name of the port.
+     @param portAddress The IP address and port number of the port.
+     @param statistics The timing of the scans and their requests. */
+    DirectionTask(const yarp::os::ConstString & portName,
+                  const string &                portAddress,
+                  ScanStatistics &              statistics) :
+        inherited(), _portName(portName), _portAddress(portAddress), _statistics(statistics),
+        _direction(PortEntry::kPortDirectionUnknown)
+    {
+    } // constructor
+    
+    /*! @brief Issue the request.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    virtual void
+    perform(MplusM::Common::CheckFunction checker,
+            void *                        checkStuff)
+    {
+        unsigned long long startTime = ScanStatistics::getTime();
+        
+        _direction = determineDirection(checker, checkStuff);
+        _statistics.record(ScanStatistics::kMeasurementDirectionRequest, startTime,
+                           _portName.c_str());
+    } // perform
+    
+    /*! @brief The name of the port. */
+    yarp::os::ConstString _portName;
+    
+    /*! @brief The IP address and port number of the port. */
+    string _portAddress;
+    
+    /*! @brief The timing of the scans and their requests. */
+    ScanStatistics & _statistics;
+    
+    /*! @brief The allowed directions for the port. */
+    PortEntry::PortDirection _direction;
+    
+private :
+    
+    COPY_AND_ASSIGNMENT_(DirectionTask);
+    
+    /*! @brief Determine whether the port can be used for input and/or output.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns The allowed directions for the port. */
+    PortEntry::PortDirection
+    determineDirection(MplusM::Common::CheckFunction checker,
+                       void *                        checkStuff)
+    {
+        ODL_OBJENTER(); //####
+        ODL_P1("checkStuff = ", checkStuff); //####
+        PortEntry::PortDirection result = PortEntry::kPortDirectionUnknown;
+        
+        if (lPortsValid)
+        {
+            bool canDoInput = false;
+            bool canDoOutput = false;
+            
+            // First, check if we are looking at a client port - because of how they are
+            // constructed, attempting to connect to them will result in a hang, so we just
+            // treat them as I/O.
+            switch (MplusM::Utilities::GetPortKind(_portName))
+            {
+                case MplusM::Utilities::kPortKindClient :
+                    canDoInput = canDoOutput = true;
+                    break;
+                
+                case MplusM::Utilities::kPortKindRegistryService :
+                case MplusM::Utilities::kPortKindService :
+                    canDoInput = true;
+                    break;
+                
+                default :
+                    // Determine by doing a test connection.
+                    if (MplusM::Utilities::NetworkConnectWithRetries(lOutputOnlyPortName,
+                                                                     _portName,
+                                                                     STANDARD_WAIT_TIME, false,
+                                                                     checker, checkStuff))
+                    {
+                        canDoInput = true;
+                        if (! MplusM::Utilities::NetworkDisconnectWithRetries(lOutputOnlyPortName,
+                                                                              _portName,
+                                                                              STANDARD_WAIT_TIME,
+                                                                              checker,
+                                                                              checkStuff))
+                        {
+                            ODL_LOG("(! MplusM::Utilities::NetworkDisconnectWithRetries(" //####
+                                   "lOutputOnlyPortName, _portName, STANDARD_WAIT_TIME, " //####
+                                   "checker, checkStuff))"); //####
+                        }
+                    }
+                    if (MplusM::Utilities::NetworkConnectWithRetries(_portName,
+                                                                     lInputOnlyPortName,
+                                                                     STANDARD_WAIT_TIME, false,
+                                                                     checker, checkStuff))
+                    {
+                        canDoOutput = true;
+                        if (! MplusM::Utilities::NetworkDisconnectWithRetries(_portName,
+                                                                              lInputOnlyPortName,
+                                                                              STANDARD_WAIT_TIME,
+                                                                              checker,
+                                                                              checkStuff))
+                        {
+                            ODL_LOG("(! MplusM::Utilities::NetworkDisconnectWithRetries(" //####
+                                   "_portName, lInputOnlyPortName, STANDARD_WAIT_TIME, " //####
+                                   "checker, checkStuff))"); //####
+                        }
+                    }
+                    break;
+                
+            }
+            if (canDoInput)
+            {
+                result = (canDoOutput ? PortEntry::kPortDirectionInputOutput :
+                          PortEntry::kPortDirectionInput);
+            }
+            else if (canDoOutput)
+            {
+                result = PortEntry::kPortDirectionOutput;
+            }
+            else
+            {
+                result = PortEntry::kPortDirectionUnknown;
+            }
+        }
+        ODL_OBJEXIT_I(static_cast<long> (result)); //####
+        return result;
+    } // determineDirection
+    
+    /*! @brief The class that this class is derived from. */
+    typedef ScanWorkerPool::Task inherited;
+    
+}; // DirectionTask
+
 #if defined(__APPLE__)
 # pragma mark Local functions
 #endif // defined(__APPLE__)
@@ -182,6 +500,7 @@ destroyDirectionTestPorts(void)
         lInputOnlyPort->close();
 #endif // defined(MpM_DoExplicitClose)
         MplusM::Common::AdapterChannel::RelinquishChannel(lInputOnlyPort);
+        lInputOnlyPort = NULL;
     }
     if (lOutputOnlyPort)
     {
@@ -189,107 +508,55 @@ destroyDirectionTestPorts(void)
         lOutputOnlyPort->close();
 #endif // defined(MpM_DoExplicitClose)
         MplusM::Common::AdapterChannel::RelinquishChannel(lOutputOnlyPort);
+        lOutputOnlyPort = NULL;
     }
     lPortsValid = false;
     ODL_EXIT(); //####
 } // destroyDirectionTestPorts
 
-/*! @brief Determine whether a port can be used for input and/or output.
- @param oldEntry The previous record for the port, if it exists.
- @param portName The name of the port to check.
- @param checker A function that provides for early exit from loops.
- @param checkStuff The private data for the early exit function.
- @returns The allowed directions for the port. */
-static PortEntry::PortDirection
-determineDirection(PortEntry *                   oldEntry,
-                   const yarp::os::ConstString & portName,
-                   MplusM::Common::CheckFunction checker,
-                   void *                        checkStuff)
+/*! @brief Return the key to be used for an entity.
+ @param kind The kind of entity.
+ @param key The key for the entity within the scan results.
+ @returns The key to be used for the entity. */
+static string
+makeEntityKey(const PortPanel::EntityKind kind,
+              const string &              key)
 {
-    ODL_ENTER(); //####
-    ODL_S1s("portName = ", portName); //####
-    ODL_P1("checkStuff = ", checkStuff); //####
-    PortEntry::PortDirection result = PortEntry::kPortDirectionUnknown;
+    string result;
     
-    if (oldEntry)
-    {
-        result = oldEntry->getDirection();
-    }
-    else if (lPortsValid)
+    switch (kind)
     {
-        bool canDoInput = false;
-        bool canDoOutput = false;
+        case PortPanel::kEntityKindClientOrAdapter :
+            result = "A " + key;
+            break;
+        
+        case PortPanel::kEntityKindService :
+            result = "S " + key;
+            break;
+        
+        default :
+            result = "P " + key;
+            break;
         
-        // First, check if we are looking at a client port - because of how they are
-        // constructed, attempting to connect to them will result in a hang, so we just
-        // treat them as I/O.
-        switch (MplusM::Utilities::GetPortKind(portName))
-        {
-            case MplusM::Utilities::kPortKindClient :
-                canDoInput = canDoOutput = true;
-                break;
-                
-            case MplusM::Utilities::kPortKindRegistryService :
-            case MplusM::Utilities::kPortKindService :
-                canDoInput = true;
-                break;
-                
-            default :
-                // Determine by doing a test connection.
-                if (MplusM::Utilities::NetworkConnectWithRetries(lOutputOnlyPortName, portName,
-                                                                 STANDARD_WAIT_TIME, false,
-                                                                 checker, checkStuff))
-                {
-                    canDoInput = true;
-                    if (! MplusM::Utilities::NetworkDisconnectWithRetries(lOutputOnlyPortName,
-                                                                          portName,
-                                                                          STANDARD_WAIT_TIME,
-                                                                          checker, checkStuff))
-                    {
-                        ODL_LOG("(! MplusM::Utilities::NetworkDisconnectWithRetries(" //####
-                               "lOutputOnlyPortName, portName, STANDARD_WAIT_TIME, " //####
-                               "checker, checkStuff))"); //####
-                    }
-                }
-                if (MplusM::Utilities::NetworkConnectWithRetries(portName, lInputOnlyPortName,
-                                                                 STANDARD_WAIT_TIME, false,
-                                                                 checker, checkStuff))
-                {
-                    canDoOutput = true;
-                    if (! MplusM::Utilities::NetworkDisconnectWithRetries(portName,
-                                                                          lInputOnlyPortName,
-                                                                          STANDARD_WAIT_TIME,
-                                                                          checker, checkStuff))
-                    {
-                        ODL_LOG("(! MplusM::Utilities::NetworkDisconnectWithRetries(" //####
-                               "portName, lInputOnlyPortName, STANDARD_WAIT_TIME, checker, " //####
-                               "checkStuff))"); //####
-                    }
-                }
-                break;
-                
-        }
-        if (canDoInput)
-        {
-            result = (canDoOutput ? PortEntry::kPortDirectionInputOutput :
-                      PortEntry::kPortDirectionInput);
-        }
-        else if (canDoOutput)
-        {
-            result = PortEntry::kPortDirectionOutput;
-        }
-        else
-        {
-            result = PortEntry::kPortDirectionUnknown;
-        }
-    }
-    else
-    {
-        result = PortEntry::kPortDirectionUnknown;
     }
-    ODL_EXIT_I(static_cast<long> (result)); //####
     return result;
-} // determineDirection
+} // makeEntityKey
+
+/*! @brief Return the attributes of a mouse event, for delivery to an entity.
+ @param where The mouse position, in display coordinates.
+ @param button The mouse button.
+ @returns The attributes of the mouse event. */
+static ofMouseEventArgs
+makeMouseEventArgs(const ofPoint & where,
+                   const int       button)
+{
+    ofMouseEventArgs result;
+    
+    result.x = where.x;
+    result.y = where.y;
+    result.button = button;
+    return result;
+} // makeMouseEventArgs
 
 /*! @brief Determine whether a connection can be made, based on the port protocols.
  @param sourceProtocol The protocol of the source port.
@@ -317,6 +584,40 @@ protocolsMatch(const string & sourceProtocol,
     return result;
 } // protocolsMatch
 
+/*! @brief Add a service to a scan, along with the ports that belong to it.
+ @param backgroundData The scan being gathered.
+ @param serviceName The name of the service port.
+ @param descriptor The descriptor of the service. */
+static void
+recordService(ScanSnapshot &                               backgroundData,
+              const string &                               serviceName,
+              const MplusM::Utilities::ServiceDescriptor & descriptor)
+{
+    ODL_ENTER(); //####
+    ODL_P2("backgroundData = ", &backgroundData, "descriptor = ", &descriptor); //####
+    ODL_S1s("serviceName = ", serviceName); //####
+    ScanSnapshot::PortSet & rememberedPorts = backgroundData.getRememberedPorts();
+    
+    backgroundData.getServices().insert(ScanSnapshot::ServiceMap::value_type(serviceName,
+                                                                             descriptor));
+    rememberedPorts.insert(descriptor._channelName);
+    for (MplusM::Common::ChannelVector::const_iterator walker = descriptor._inputChannels.begin();
+         descriptor._inputChannels.end() != walker; ++walker)
+    {
+        MplusM::Common::ChannelDescription aChannel(*walker);
+        
+        rememberedPorts.insert(aChannel._portName);
+    }
+    for (MplusM::Common::ChannelVector::const_iterator walker = descriptor._outputChannels.begin();
+         descriptor._outputChannels.end() != walker; ++walker)
+    {
+        MplusM::Common::ChannelDescription aChannel(*walker);
+        
+        rememberedPorts.insert(aChannel._portName);
+    }
+    ODL_EXIT(); //####
+} // recordService
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -326,17 +627,23 @@ protocolsMatch(const string & sourceProtocol,
 #endif // defined(__APPLE__)
 
 ServiceViewerApp::ServiceViewerApp(void) :
-    inherited(), _entities1(), _entities2(), _ports1(), _ports2(), _backgroundEntities(&_entities1),
-    _foregroundEntities(&_entities2), _backgroundPorts(&_ports1), _foregroundPorts(&_ports2),
-    _firstAddPort(NULL), _firstRemovePort(NULL), _scanner(new BackgroundScanner(*this,
-                                                                                kMinScanInterval)),
+    inherited(), _foregroundEntities(), _entityMap(), _unplacedKeys(), _foregroundPorts(),
+    _scanBuffer(), _statistics(), _previousScan(), _foregroundData(), _connectionRenderer(),
+    _entityGrid(), _directionCache(), _descriptorCache(kMaxDescriptorAge), _firstAddPort(NULL),
+    _firstRemovePort(NULL),
+    _scanner(new BackgroundScanner(*this, kMinScanInterval, kMaxScanInterval,
+                                   kConnectionScanInterval)),
+    _layoutWorker(new LayoutWorker(_statistics)),
+    _scanWorkers(new ScanWorkerPool(kScanWorkerCount, kScanRequestDuration)),
+    _mouseTarget(NULL), _changeFeed(NULL), _scanSource(new YarpScanSource),
+    _lastStatisticsSaveTime(0), _panAnchor(), _viewOrigin(), _viewScale(1),
 #if defined(CHECK_FOR_STALE_PORTS)
     _lastStaleTime(- (2 * kMinStaleInterval)),
 #endif // defined(CHECK_FOR_STALE_PORTS)
     _addingUDPConnection(false), _addIsActive(false),
     _altActive(false), _commandActive(false), _controlActive(false), _dragActive(false),
-    _ignoreNextScan(false), _movementActive(false), _networkAvailable(false),
-    _registryAvailable(false), _removeIsActive(false), _shiftActive(false)
+    _movementActive(false), _networkAvailable(false), _panActive(false), _registryAvailable(false),
+    _removeIsActive(false), _shiftActive(false), _statisticsVisible(false)
 {
     ODL_ENTER(); //####
     ODL_EXIT_P(this); //####
@@ -346,21 +653,59 @@ ServiceViewerApp::ServiceViewerApp(void) :
 # pragma mark Actions and Accessors
 #endif // defined(__APPLE__)
 
-void
-ServiceViewerApp::addEntityToBackground(ServiceEntity * anEntity)
+ServiceEntity *
+ServiceViewerApp::addAdapterEntity(const string &                          caption,
+                                   const ScanSnapshot::PortAndAssociates & associates)
 {
     ODL_OBJENTER(); //####
-    ODL_P1("anEntity = ", anEntity); //####
-    _backgroundEntities->push_back(anEntity);
-    ODL_OBJEXIT(); //####
-} // ServiceViewerApp::addEntityToBackground
+    ODL_S1s("caption = ", caption); //####
+    ODL_P1("associates = ", &associates); //####
+    PortEntry *     aPort;
+    ServiceEntity * anEntity = new ServiceEntity(PortPanel::kEntityKindClientOrAdapter, "", "",
+                                                 *this);
+    
+    anEntity->setup(caption);
+    for (MplusM::Common::StringVector::const_iterator walker =
+                                                            associates._associates._inputs.begin();
+         associates._associates._inputs.end() != walker; ++walker)
+    {
+        aPort = anEntity->addPort(*walker, "", PortEntry::kPortUsageOther,
+                                  PortEntry::kPortDirectionInput);
+        if (aPort)
+        {
+            rememberPortInForeground(aPort);
+        }
+    }
+    for (MplusM::Common::StringVector::const_iterator walker =
+                                                            associates._associates._outputs.begin();
+         associates._associates._outputs.end() != walker; ++walker)
+    {
+        aPort = anEntity->addPort(*walker, "", PortEntry::kPortUsageOther,
+                                  PortEntry::kPortDirectionOutput);
+        if (aPort)
+        {
+            rememberPortInForeground(aPort);
+        }
+    }
+    aPort = anEntity->addPort(associates._name, "", PortEntry::kPortUsageClient,
+                              PortEntry::kPortDirectionInputOutput);
+    if (aPort)
+    {
+        rememberPortInForeground(aPort);
+    }
+    addEntityToForeground(anEntity);
+    _entityMap[makeEntityKey(PortPanel::kEntityKindClientOrAdapter, caption)] = anEntity;
+    ODL_OBJEXIT_P(anEntity); //####
+    return anEntity;
+} // ServiceViewerApp::addAdapterEntity
 
 void
 ServiceViewerApp::addEntityToForeground(ServiceEntity * anEntity)
 {
     ODL_OBJENTER(); //####
     ODL_P1("anEntity = ", anEntity); //####
-    _foregroundEntities->push_back(anEntity);
+    _foregroundEntities.push_back(anEntity);
+    _entityGrid.raise(anEntity);
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::addEntityToForeground
 
@@ -371,29 +716,53 @@ ServiceViewerApp::addPortConnectionsToBackground(const MplusM::Utilities::PortVe
 {
     ODL_OBJENTER(); //####
     ODL_P1("detectedPorts = ", &detectedPorts); //####
+    ScanSnapshot &                 backgroundData = _scanBuffer.getWriteSnapshot();
+    ScanSnapshot::ConnectionList & connections = backgroundData.getConnections();
+    ScanSnapshot::PortSet &        rememberedPorts = backgroundData.getRememberedPorts();
+    ScanWorkerPool::TaskList       requests;
+    std::set<string>               requested;
+    std::set<string>               seenConnections;
+    
+    // Gather the requests first, so that they can be issued concurrently.
     for (MplusM::Utilities::PortVector::const_iterator outer(detectedPorts.begin());
          detectedPorts.end() != outer; ++outer)
     {
-        if (_rememberedPorts.end() != _rememberedPorts.find(outer->_portName))
+        if ((rememberedPorts.end() != rememberedPorts.find(outer->_portName)) &&
+            requested.insert(outer->_portName.c_str()).second)
+        {
+            requests.push_back(new ConnectionsTask(*_scanSource, outer->_portName,
+                                                   _statistics));
+        }
+    }
+    if (_scanWorkers)
+    {
+        _scanWorkers->perform(requests, checker, checkStuff);
+    }
+    for (ScanWorkerPool::TaskList::const_iterator outer(requests.begin());
+         requests.end() != outer; ++outer)
+    {
+        ConnectionsTask * aRequest = static_cast<ConnectionsTask *> (*outer);
+        
+        if (aRequest)
         {
-            ConnectionDetails             details;
-            MplusM::Common::ChannelVector inputs;
-            MplusM::Common::ChannelVector outputs;
+            ScanSnapshot::ConnectionDetails details;
             
-            details._outPortName = outer->_portName;
-            MplusM::Utilities::GatherPortConnections(outer->_portName, inputs, outputs,
-                                                     MplusM::Utilities::kInputAndOutputOutput,
-                                                     true, checker, checkStuff);
-            for (MplusM::Common::ChannelVector::const_iterator inner(outputs.begin());
-                 outputs.end() != inner; ++inner)
+            details._outPortName = aRequest->_portName;
+            for (MplusM::Common::ChannelVector::const_iterator inner(aRequest->_outputs.begin());
+                 aRequest->_outputs.end() != inner; ++inner)
             {
-                if (_rememberedPorts.end() != _rememberedPorts.find(inner->_portName))
+                string connectionKey(string(aRequest->_portName.c_str()) + " " +
+                                     inner->_portName.c_str());
+                
+                if ((rememberedPorts.end() != rememberedPorts.find(inner->_portName)) &&
+                    seenConnections.insert(connectionKey).second)
                 {
                     details._inPortName = inner->_portName;
                     details._mode = inner->_portMode;
-                    _connections.push_back(details);
+                    connections.push_back(details);
                 }
             }
+            delete aRequest;
         }
     }
     ODL_OBJEXIT(); //####
@@ -406,15 +775,25 @@ ServiceViewerApp::addPortsWithAssociatesToBackground(const MplusM::Utilities::Po
 {
     ODL_OBJENTER(); //####
     ODL_P2("detectedPorts = ", &detectedPorts, "checkStuff = ", checkStuff); //####
+    ScanSnapshot &                backgroundData = _scanBuffer.getWriteSnapshot();
+    ScanSnapshot::AssociatesMap & associatedPorts = backgroundData.getAssociates();
+    ScanSnapshot::PortSet &       rememberedPorts = backgroundData.getRememberedPorts();
+    
     for (MplusM::Utilities::PortVector::const_iterator outer(detectedPorts.begin());
          detectedPorts.end() != outer; ++outer)
     {
-        if (_rememberedPorts.end() == _rememberedPorts.find(outer->_portName))
+        if (rememberedPorts.end() == rememberedPorts.find(outer->_portName))
         {
-            PortAndAssociates associates;
+            ScanSnapshot::PortAndAssociates associates;
+            unsigned long long              startTime = ScanStatistics::getTime();
+            bool                            gotAssociates =
+                                    _scanSource->getAssociatedPorts(outer->_portName,
+                                                                    associates._associates,
+                                                                    checker, checkStuff);
             
-            if (MplusM::Utilities::GetAssociatedPorts(outer->_portName, associates._associates,
-                                                      STANDARD_WAIT_TIME, checker, checkStuff))
+            _statistics.record(ScanStatistics::kMeasurementAssociatesRequest, startTime,
+                               outer->_portName.c_str());
+            if (gotAssociates)
             {
                 if (associates._associates._primary)
                 {
@@ -422,19 +801,20 @@ ServiceViewerApp::addPortsWithAssociatesToBackground(const MplusM::Utilities::Po
                                                   outer->_portPortNumber);
                     
                     associates._name = outer->_portName;
-                    _associatedPorts.insert(AssociatesMap::value_type(caption.c_str(), associates));
-                    _rememberedPorts.insert(outer->_portName);
+                    associatedPorts.insert(ScanSnapshot::AssociatesMap::value_type(caption.c_str(),
+                                                                                   associates));
+                    rememberedPorts.insert(outer->_portName);
                     for (MplusM::Common::StringVector::const_iterator inner =
                                                             associates._associates._inputs.begin();
                          associates._associates._inputs.end() != inner; ++inner)
                     {
-                        _rememberedPorts.insert(*inner);
+                        rememberedPorts.insert(*inner);
                     }
                     for (MplusM::Common::StringVector::const_iterator inner =
                                                             associates._associates._outputs.begin();
                          associates._associates._outputs.end() != inner; ++inner)
                     {
-                        _rememberedPorts.insert(*inner);
+                        rememberedPorts.insert(*inner);
                     }
                 }
             }
@@ -450,65 +830,423 @@ ServiceViewerApp::addRegularPortEntitiesToBackground(const MplusM::Utilities::Po
 {
     ODL_OBJENTER(); //####
     ODL_P2("detectedPorts = ", &detectedPorts, "checkStuff = ", checkStuff); //####
+    ScanSnapshot &           backgroundData = _scanBuffer.getWriteSnapshot();
+    ScanSnapshot::PortSet &  rememberedPorts = backgroundData.getRememberedPorts();
+    ScanSnapshot::PortMap &  standalonePorts = backgroundData.getStandalonePorts();
+    ScanWorkerPool::TaskList requests;
+    
     for (MplusM::Utilities::PortVector::const_iterator walker(detectedPorts.begin());
          detectedPorts.end() != walker; ++walker)
     {
-        if (_rememberedPorts.end() == _rememberedPorts.find(walker->_portName))
+        if (rememberedPorts.end() == rememberedPorts.find(walker->_portName))
         {
-            yarp::os::ConstString caption(walker->_portIpAddress + ":" + walker->_portPortNumber);
-            NameAndDirection      info;
-            PortEntry *           oldEntry = findForegroundPort(walker->_portName);
+            yarp::os::ConstString          caption(walker->_portIpAddress + ":" +
+                                                   walker->_portPortNumber);
+            ScanSnapshot::NameAndDirection info;
             
-            _rememberedPorts.insert(walker->_portName);
+            rememberedPorts.insert(walker->_portName);
             info._name = walker->_portName;
-            info._direction = determineDirection(oldEntry, walker->_portName, checker, checkStuff);
-            _standalonePorts.insert(PortMap::value_type(caption.c_str(), info));
+            if ((! _scanSource->lookupDirection(walker->_portName, info._direction)) &&
+                (! _directionCache.lookup(walker->_portName.c_str(), caption.c_str(),
+                                          info._direction)))
+            {
+                // Defer the check, so that the ports can be tested in parallel.
+                info._direction = PortEntry::kPortDirectionUnknown;
+                requests.push_back(new DirectionTask(walker->_portName, caption.c_str(),
+                                                     _statistics));
+            }
+            standalonePorts.insert(ScanSnapshot::PortMap::value_type(caption.c_str(), info));
         }
     }
+    unsigned long long startTime = ScanStatistics::getTime();
+    
+    if (_scanWorkers)
+    {
+        _scanWorkers->perform(requests, checker, checkStuff);
+    }
+    _statistics.record(ScanStatistics::kMeasurementDirectionProbing, startTime);
+    for (ScanWorkerPool::TaskList::const_iterator walker(requests.begin());
+         requests.end() != walker; ++walker)
+    {
+        DirectionTask * aRequest = static_cast<DirectionTask *> (*walker);
+        
+        if (aRequest)
+        {
+            ScanSnapshot::PortMap::iterator match(standalonePorts.find(aRequest->_portAddress));
+            
+            if (standalonePorts.end() != match)
+            {
+                match->second._direction = aRequest->_direction;
+            }
+            _directionCache.remember(aRequest->_portName.c_str(), aRequest->_portAddress,
+                                     aRequest->_direction);
+            delete aRequest;
+        }
+    }
+    for (ScanSnapshot::PortMap::const_iterator walker(standalonePorts.begin());
+         standalonePorts.end() != walker; ++walker)
+    {
+        _scanSource->rememberDirection(walker->second._name.c_str(), walker->second._direction);
+    }
+    // The ports that have not been seen for a while are forgotten during the session, and not just
+    // when the cache is saved.
+    _directionCache.removeExpiredEntries();
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::addRegularPortEntitiesToBackground
 
 void
-ServiceViewerApp::addServicesToBackground(const MplusM::Common::StringVector & services,
-                                          MplusM::Common::CheckFunction        checker,
-                                          void *                               checkStuff)
+ServiceViewerApp::addServicesToBackground(const MplusM::Common::StringVector &  services,
+                                          const MplusM::Utilities::PortVector & detectedPorts,
+                                          MplusM::Common::CheckFunction         checker,
+                                          void *                                checkStuff)
 {
     ODL_OBJENTER(); //####
-    ODL_P2("services = ", &services, "checkStuff = ", checkStuff); //####
+    ODL_P3("services = ", &services, "detectedPorts = ", &detectedPorts, "checkStuff = ", //####
+           checkStuff); //####
+    ScanSnapshot &             backgroundData = _scanBuffer.getWriteSnapshot();
+    ScanSnapshot::ServiceMap & detectedServices = backgroundData.getServices();
+    ScanWorkerPool::TaskList   requests;
+    std::set<string>           presentServices;
+    std::map<string, string>   addresses;
+    
+    for (MplusM::Utilities::PortVector::const_iterator walker(detectedPorts.begin());
+         detectedPorts.end() != walker; ++walker)
+    {
+        yarp::os::ConstString caption(walker->_portIpAddress + ":" + walker->_portPortNumber);
+        
+        addresses[walker->_portName.c_str()] = caption.c_str();
+    }
+    // Only the services that are new, have moved or have not been checked for a while are asked
+    // for their descriptors; the requests are gathered first, so that they can be issued
+    // concurrently.
     for (MplusM::Common::StringVector::const_iterator outer(services.begin());
          services.end() != outer; ++outer)
     {
-        if (_detectedServices.end() == _detectedServices.find(outer->c_str()))
+        string serviceName(outer->c_str());
+        
+        if ((detectedServices.end() == detectedServices.find(serviceName)) &&
+            presentServices.insert(serviceName).second)
         {
             MplusM::Utilities::ServiceDescriptor descriptor;
+            string                               serviceAddress(addresses[serviceName]);
             
-            if (MplusM::Utilities::GetNameAndDescriptionForService(*outer, descriptor,
-                                                                   STANDARD_WAIT_TIME, checker,
-                                                                   checkStuff))
+            if (_descriptorCache.lookup(serviceName, serviceAddress, descriptor))
+            {
+                recordService(backgroundData, serviceName, descriptor);
+            }
+            else
             {
-                _detectedServices.insert(ServiceMap::value_type(outer->c_str(), descriptor));
-                _rememberedPorts.insert(descriptor._channelName);
-                for (MplusM::Common::ChannelVector::const_iterator inner =
+                requests.push_back(new DescriptorTask(*_scanSource, *outer, serviceAddress,
+                                                      _statistics));
+            }
+        }
+    }
+    _descriptorCache.removeMissingEntries(presentServices);
+    if (_scanWorkers)
+    {
+        _scanWorkers->perform(requests, checker, checkStuff);
+    }
+    for (ScanWorkerPool::TaskList::const_iterator outer(requests.begin());
+         requests.end() != outer; ++outer)
+    {
+        DescriptorTask * aRequest = static_cast<DescriptorTask *> (*outer);
+        
+        if (aRequest)
+        {
+            if (aRequest->_succeeded)
+            {
+                string serviceName(aRequest->_serviceName.c_str());
+                
+                _descriptorCache.remember(serviceName, aRequest->_serviceAddress,
+                                          aRequest->_descriptor);
+                recordService(backgroundData, serviceName, aRequest->_descriptor);
+            }
+            delete aRequest;
+        }
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::addServicesToBackground
+
+ServiceEntity *
+ServiceViewerApp::addServiceEntity(const MplusM::Utilities::ServiceDescriptor & descriptor)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("descriptor = ", &descriptor); //####
+    ServiceEntity * anEntity = new ServiceEntity(PortPanel::kEntityKindService,
+                                                 descriptor._kind.c_str(),
+                                                 descriptor._description.c_str(), *this);
+    
+    anEntity->setup(descriptor._serviceName.c_str());
+    PortEntry * aPort = anEntity->addPort(descriptor._channelName.c_str(), "",
+                                          PortEntry::kPortUsageService,
+                                          PortEntry::kPortDirectionInput);
+    
+    if (aPort)
+    {
+        rememberPortInForeground(aPort);
+    }
+    for (MplusM::Common::ChannelVector::const_iterator walker =
                                                                 descriptor._inputChannels.begin();
-                     descriptor._inputChannels.end() != inner; ++inner)
-                {
-                    MplusM::Common::ChannelDescription aChannel(*inner);
-                    
-                    _rememberedPorts.insert(aChannel._portName);
-                }
-                for (MplusM::Common::ChannelVector::const_iterator inner =
+         descriptor._inputChannels.end() != walker; ++walker)
+    {
+        aPort = anEntity->addPort(walker->_portName.c_str(), walker->_portProtocol.c_str(),
+                                  PortEntry::kPortUsageInputOutput,
+                                  PortEntry::kPortDirectionInput);
+        if (aPort)
+        {
+            rememberPortInForeground(aPort);
+        }
+    }
+    for (MplusM::Common::ChannelVector::const_iterator walker =
                                                                 descriptor._outputChannels.begin();
-                     descriptor._outputChannels.end() != inner; ++inner)
-                {
-                    MplusM::Common::ChannelDescription aChannel(*inner);
-                    
-                    _rememberedPorts.insert(aChannel._portName);
-                }
+         descriptor._outputChannels.end() != walker; ++walker)
+    {
+        aPort = anEntity->addPort(walker->_portName.c_str(), walker->_portProtocol.c_str(),
+                                  PortEntry::kPortUsageInputOutput,
+                                  PortEntry::kPortDirectionOutput);
+        if (aPort)
+        {
+            rememberPortInForeground(aPort);
+        }
+    }
+    addEntityToForeground(anEntity);
+    _entityMap[makeEntityKey(PortPanel::kEntityKindService,
+                             descriptor._channelName.c_str())] = anEntity;
+    ODL_OBJEXIT_P(anEntity); //####
+    return anEntity;
+} // ServiceViewerApp::addServiceEntity
+
+ServiceEntity *
+ServiceViewerApp::addStandalonePortEntity(const string &                         caption,
+                                          const ScanSnapshot::NameAndDirection & info)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("caption = ", caption); //####
+    ODL_P1("info = ", &info); //####
+    ServiceEntity *      anEntity = new ServiceEntity(PortPanel::kEntityKindOther, "", "", *this);
+    PortEntry::PortUsage usage;
+    
+    anEntity->setup(caption);
+    switch (MplusM::Utilities::GetPortKind(info._name.c_str()))
+    {
+        case MplusM::Utilities::kPortKindClient :
+            usage = PortEntry::kPortUsageClient;
+            break;
+        
+        case MplusM::Utilities::kPortKindRegistryService :
+        case MplusM::Utilities::kPortKindService :
+            usage = PortEntry::kPortUsageService;
+            break;
+        
+        default :
+            usage = PortEntry::kPortUsageOther;
+            break;
+        
+    }
+    PortEntry * aPort = anEntity->addPort(info._name, "", usage, info._direction);
+    
+    if (aPort)
+    {
+        rememberPortInForeground(aPort);
+    }
+    addEntityToForeground(anEntity);
+    _entityMap[makeEntityKey(PortPanel::kEntityKindOther, caption)] = anEntity;
+    ODL_OBJEXIT_P(anEntity); //####
+    return anEntity;
+} // ServiceViewerApp::addStandalonePortEntity
+
+bool
+ServiceViewerApp::applyLatestScan(void)
+{
+    ODL_OBJENTER(); //####
+    bool changed = false;
+    
+    if (_scanBuffer.takeLatest())
+    {
+        ScanSnapshot &      latestData = _scanBuffer.getReadSnapshot();
+        ScanSnapshot::Delta delta;
+        unsigned long long  startTime = ScanStatistics::getTime();
+        
+        // Only the differences from the currently displayed scan need to be applied.
+        latestData.computeDelta(_foregroundData, delta);
+        if (! delta.isEmpty())
+        {
+            applyScanDelta(latestData, delta);
+            changed = true;
+        }
+        _foregroundData.swap(latestData);
+        _statistics.record(ScanStatistics::kMeasurementApplyScan, startTime);
+    }
+    ODL_OBJEXIT_B(changed); //####
+    return changed;
+} // ServiceViewerApp::applyLatestScan
+
+void
+ServiceViewerApp::applyLayoutResults(const LayoutWorker::PositionMap & newPositions)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("newPositions = ", &newPositions); //####
+    for (LayoutWorker::PositionMap::const_iterator walker(newPositions.begin());
+         newPositions.end() != walker; ++walker)
+    {
+        // Entities that were removed, or that were moved by the user, while the layout was being
+        // calculated are ignored.
+        EntityMap::const_iterator match(_entityMap.find(walker->first));
+        
+        if ((_entityMap.end() != match) && match->second &&
+            (_unplacedKeys.end() != _unplacedKeys.find(walker->first)))
+        {
+            match->second->setPosition(walker->second.x, walker->second.y);
+            _entityGrid.update(match->second);
+        }
+        _unplacedKeys.erase(walker->first);
+    }
+    _connectionRenderer.invalidate();
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::applyLayoutResults
+
+void
+ServiceViewerApp::applyScanDelta(const ScanSnapshot &        newer,
+                                 const ScanSnapshot::Delta & delta)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("newer = ", &newer, "delta = ", &delta); //####
+    EntityList                          newEntities;
+    PositionMap                         oldPositions;
+    const ScanSnapshot::AssociatesMap & associatedPorts = newer.getAssociates();
+    const ScanSnapshot::PortMap &       standalonePorts = newer.getStandalonePorts();
+    const ScanSnapshot::ServiceMap &    detectedServices = newer.getServices();
+    
+    // Remove the connections that have vanished, while both ends are still present.
+    for (ScanSnapshot::ConnectionList::const_iterator walker(delta._removedConnections.begin());
+         delta._removedConnections.end() != walker; ++walker)
+    {
+        PortEntry * thisPort = findForegroundPort(walker->_outPortName);
+        PortEntry * otherPort = findForegroundPort(walker->_inPortName);
+        
+        if (thisPort && otherPort)
+        {
+            thisPort->removeOutputConnection(otherPort);
+            otherPort->removeInputConnection(thisPort);
+        }
+    }
+    // Remove the entities that have vanished or changed, remembering where they were.
+    for (ScanSnapshot::KeyList::const_iterator walker(delta._removedServices.begin());
+         delta._removedServices.end() != walker; ++walker)
+    {
+        removeForegroundEntity(makeEntityKey(PortPanel::kEntityKindService, *walker),
+                               oldPositions);
+    }
+    for (ScanSnapshot::KeyList::const_iterator walker(delta._removedAssociates.begin());
+         delta._removedAssociates.end() != walker; ++walker)
+    {
+        removeForegroundEntity(makeEntityKey(PortPanel::kEntityKindClientOrAdapter, *walker),
+                               oldPositions);
+    }
+    for (ScanSnapshot::KeyList::const_iterator walker(delta._removedPorts.begin());
+         delta._removedPorts.end() != walker; ++walker)
+    {
+        removeForegroundEntity(makeEntityKey(PortPanel::kEntityKindOther, *walker), oldPositions);
+    }
+    // Add the entities that have appeared or changed; changed entities stay where they were.
+    for (ScanSnapshot::KeyList::const_iterator walker(delta._addedServices.begin());
+         delta._addedServices.end() != walker; ++walker)
+    {
+        ScanSnapshot::ServiceMap::const_iterator match(detectedServices.find(*walker));
+        
+        if (detectedServices.end() != match)
+        {
+            ServiceEntity *             anEntity = addServiceEntity(match->second);
+            PositionMap::const_iterator oldPosition =
+                    oldPositions.find(makeEntityKey(PortPanel::kEntityKindService, *walker));
+            
+            if (oldPositions.end() == oldPosition)
+            {
+                newEntities.push_back(anEntity);
+            }
+            else
+            {
+                anEntity->setPosition(oldPosition->second.x, oldPosition->second.y);
             }
         }
     }
+    for (ScanSnapshot::KeyList::const_iterator walker(delta._addedAssociates.begin());
+         delta._addedAssociates.end() != walker; ++walker)
+    {
+        ScanSnapshot::AssociatesMap::const_iterator match(associatedPorts.find(*walker));
+        
+        if (associatedPorts.end() != match)
+        {
+            ServiceEntity *             anEntity = addAdapterEntity(match->first, match->second);
+            PositionMap::const_iterator oldPosition =
+                    oldPositions.find(makeEntityKey(PortPanel::kEntityKindClientOrAdapter,
+                                                    *walker));
+            
+            if (oldPositions.end() == oldPosition)
+            {
+                newEntities.push_back(anEntity);
+            }
+            else
+            {
+                anEntity->setPosition(oldPosition->second.x, oldPosition->second.y);
+            }
+        }
+    }
+    for (ScanSnapshot::KeyList::const_iterator walker(delta._addedPorts.begin());
+         delta._addedPorts.end() != walker; ++walker)
+    {
+        ScanSnapshot::PortMap::const_iterator match(standalonePorts.find(*walker));
+        
+        if (standalonePorts.end() != match)
+        {
+            ServiceEntity *             anEntity = addStandalonePortEntity(match->first,
+                                                                           match->second);
+            PositionMap::const_iterator oldPosition =
+                    oldPositions.find(makeEntityKey(PortPanel::kEntityKindOther, *walker));
+            
+            if (oldPositions.end() == oldPosition)
+            {
+                newEntities.push_back(anEntity);
+            }
+            else
+            {
+                anEntity->setPosition(oldPosition->second.x, oldPosition->second.y);
+            }
+        }
+    }
+    // Add the connections that have appeared. Note that connections to an entity that was
+    // re-created will be in the full set of connections, rather than in the differences.
+    const ScanSnapshot::ConnectionList & connections = ((delta._removedServices.empty() &&
+                                                         delta._removedAssociates.empty() &&
+                                                         delta._removedPorts.empty()) ?
+                                                        delta._addedConnections :
+                                                        newer.getConnections());
+    
+    for (ScanSnapshot::ConnectionList::const_iterator walker(connections.begin());
+         connections.end() != walker; ++walker)
+    {
+        PortEntry * thisPort = findForegroundPort(walker->_outPortName);
+        PortEntry * otherPort = findForegroundPort(walker->_inPortName);
+        
+        if (thisPort && otherPort)
+        {
+            thisPort->addOutputConnection(otherPort, walker->_mode);
+            otherPort->addInputConnection(thisPort, walker->_mode);
+        }
+    }
+    if (! newEntities.empty())
+    {
+        setEntityPositions(newEntities);
+    }
+    // Adding or removing ports changes the size of an entity, so all the bounds are refreshed.
+    for (EntityList::const_iterator it(_foregroundEntities.begin());
+         _foregroundEntities.end() != it; ++it)
+    {
+        _entityGrid.update(*it);
+    }
+    _connectionRenderer.invalidate();
     ODL_OBJEXIT(); //####
-} // ServiceViewerApp::addServicesToBackground
+} // ServiceViewerApp::applyScanDelta
 
 void
 ServiceViewerApp::clearDragState(void)
@@ -530,11 +1268,11 @@ ServiceViewerApp::clearDragState(void)
 } // ServiceViewerApp::clearDragState
 
 void
-ServiceViewerApp::clearOutBackgroundData(void)
+ServiceViewerApp::clearForeground(void)
 {
     ODL_OBJENTER(); //####
-    for (EntityList::const_iterator it(_backgroundEntities->begin());
-         _backgroundEntities->end() != it; ++it)
+    for (EntityList::const_iterator it(_foregroundEntities.begin());
+         _foregroundEntities.end() != it; ++it)
     {
         ServiceEntity * anEntity = *it;
         
@@ -543,16 +1281,17 @@ ServiceViewerApp::clearOutBackgroundData(void)
             delete anEntity;
         }
     }
-    _backgroundEntities->clear();
+    _foregroundEntities.clear();
+    _entityGrid.clear();
+    _mouseTarget = NULL;
+    _entityMap.clear();
+    _unplacedKeys.clear();
     // Note that the ports will have been deleted by the deletion of the entities.
-    _backgroundPorts->clear();
-    _detectedServices.clear();
-    _rememberedPorts.clear();
-    _associatedPorts.clear();
-    _standalonePorts.clear();
-    _connections.clear();
+    _foregroundPorts.clear();
+    _foregroundData.clear();
+    _connectionRenderer.invalidate();
     ODL_OBJEXIT(); //####
-} // ServiceViewerApp::clearOutBackgroundData
+} // ServiceViewerApp::clearForeground
 
 void
 ServiceViewerApp::dragEvent(ofDragInfo dragInfo)
@@ -569,27 +1308,35 @@ ServiceViewerApp::draw(void)
     ofBackgroundGradient(ofColor::white, ofColor::gray);
     if (_networkAvailable)
     {
-        _foregroundLock.lock();
-        for (EntityList::const_iterator it(_foregroundEntities->begin());
-             _foregroundEntities->end() != it; ++it)
+        ofRectangle viewBounds(getViewBounds());
+        bool        detailed = (kMinDetailScale <= _viewScale);
+        
+        ofPushMatrix();
+        ofScale(_viewScale, _viewScale);
+        ofTranslate(- _viewOrigin.x, - _viewOrigin.y);
+        // Entities that are entirely outside the window are not drawn.
+        for (EntityList::const_iterator it(_foregroundEntities.begin());
+             _foregroundEntities.end() != it; ++it)
         {
             ServiceEntity * anEntity = *it;
             
-            if (anEntity && (! anEntity->isSelected()))
+            if (anEntity && (! anEntity->isSelected()) &&
+                viewBounds.intersects(anEntity->getShape()))
             {
-                anEntity->draw();
+                anEntity->draw(detailed);
             }
         }
-        for (EntityList::const_iterator it(_foregroundEntities->begin());
-             _foregroundEntities->end() != it; ++it)
+        for (EntityList::const_iterator it(_foregroundEntities.begin());
+             _foregroundEntities.end() != it; ++it)
         {
             ServiceEntity * anEntity = *it;
             
-            if (anEntity && anEntity->isSelected())
+            if (anEntity && anEntity->isSelected() && viewBounds.intersects(anEntity->getShape()))
             {
-                anEntity->draw();
+                anEntity->draw(detailed);
             }
         }
+        _connectionRenderer.draw(_foregroundEntities, viewBounds, detailed);
         if (_dragActive)
         {
             if (_firstAddPort)
@@ -601,7 +1348,11 @@ ServiceViewerApp::draw(void)
                 _dragActive = false;
             }
         }
-        _foregroundLock.unlock();
+        ofPopMatrix();
+        if (_statisticsVisible)
+        {
+            drawStatistics();
+        }
     }
     else
     {
@@ -621,86 +1372,89 @@ ServiceViewerApp::draw(void)
 } // ServiceViewerApp::draw
 
 void
-ServiceViewerApp::exit(void)
+ServiceViewerApp::drawStatistics(void)
 {
     ODL_OBJENTER(); //####
-    if (_scanner && _scanner->isThreadRunning())
+    std::vector<string> lines;
+    string              text;
+    
+    // The current interval shows how the scanner has adapted to the activity on the network.
+    if (_scanner)
     {
-        _scanner->stopThread();
+        text = "scanInterval: " + ofToString(_scanner->getScanInterval(), 1) + " s\n";
+    }
+    _statistics.describe(lines);
+    for (std::vector<string>::const_iterator walker(lines.begin()); lines.end() != walker;
+         ++walker)
+    {
+        text += *walker + "\n";
+    }
+    if (! text.empty())
+    {
+        ofDrawBitmapStringHighlight(text, kStatisticsMargin, kStatisticsMargin);
     }
-    destroyDirectionTestPorts();
-    clearOutBackgroundData();
-    MplusM::Utilities::ShutDownGlobalStatusReporter();
-    inherited::exit();
     ODL_OBJEXIT(); //####
-} // ServiceViewerApp::exit
+} // ServiceViewerApp::drawStatistics
 
-PortEntry *
-ServiceViewerApp::findBackgroundPort(const string & name)
+void
+ServiceViewerApp::exit(void)
 {
     ODL_OBJENTER(); //####
-    ODL_S1s("name = ", name); //####
-    PortEntry *                  result;
-    PortEntryMap::const_iterator match(_backgroundPorts->find(name));
-    
-    if (_backgroundPorts->end() == match)
+    if (_scanner)
     {
-        result = NULL;
+        _scanner->shutDown();
+        delete _scanner;
+        _scanner = NULL;
     }
-    else
+    if (_layoutWorker)
     {
-        result = match->second;
+        _layoutWorker->shutDown();
+        delete _layoutWorker;
+        _layoutWorker = NULL;
     }
-    ODL_OBJEXIT_P(result); //####
-    return result;
-} // ServiceViewerApp::findBackgroundPort
-
-ServiceEntity *
-ServiceViewerApp::findForegroundEntity(const string & name)
-{
-    ODL_OBJENTER(); //####
-    ODL_S1s("name = ", name); //####
-    ServiceEntity * result = NULL;
-    
-    for (EntityList::const_iterator it(_foregroundEntities->begin());
-         _foregroundEntities->end() != it; ++it)
+    if (_scanWorkers)
     {
-        ServiceEntity * anEntity = *it;
-        
-        if (anEntity && (name == anEntity->getName()))
-        {
-            result = anEntity;
-            break;
-        }
-        
+        _scanWorkers->shutDown();
+        delete _scanWorkers;
+        _scanWorkers = NULL;
     }
-    ODL_OBJEXIT_P(result); //####
-    return result;
-} // ServiceViewerApp::findForegroundEntity
+    if (_changeFeed)
+    {
+        delete _changeFeed;
+        _changeFeed = NULL;
+    }
+    destroyDirectionTestPorts();
+    clearForeground();
+    _previousScan.clear();
+    // The directions of a generated network are not worth keeping.
+    if (_scanSource && _scanSource->requiresDirectionProbing() &&
+        (! _directionCache.save(ofToDataPath(DIRECTION_CACHE_FILE))))
+    {
+        ODL_LOG("(_scanSource && _scanSource->requiresDirectionProbing() && " //####
+                "(! _directionCache.save(ofToDataPath(DIRECTION_CACHE_FILE))))"); //####
+    }
+    _scanBuffer.clear();
+    if (! _statistics.save(ofToDataPath(STATISTICS_FILE)))
+    {
+        ODL_LOG("(! _statistics.save(ofToDataPath(STATISTICS_FILE)))"); //####
+    }
+    if (_scanSource)
+    {
+        _scanSource->stop();
+        delete _scanSource;
+        _scanSource = NULL;
+    }
+    inherited::exit();
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::exit
 
 ServiceEntity *
 ServiceViewerApp::findForegroundEntityForPort(const string & name)
 {
     ODL_OBJENTER(); //####
     ODL_S1s("name = ", name); //####
-    PortEntryMap::const_iterator match(_foregroundPorts->find(name));
-    ServiceEntity *              result = NULL;
+    ServiceEntity * result = findForegroundEntityForPort(findForegroundPort(name));
     
-    if (_foregroundPorts->end() != match)
-    {
-        for (EntityList::const_iterator it(_foregroundEntities->begin());
-             _foregroundEntities->end() != it; ++it)
-        {
-            ServiceEntity * anEntity = *it;
-            
-            if (anEntity && anEntity->hasPort(match->second))
-            {
-                result = anEntity;
-                break;
-            }
-            
-        }
-    }
     ODL_OBJEXIT_P(result); //####
     return result;
 } // ServiceViewerApp::findForegroundEntityForPort
@@ -712,17 +1466,15 @@ ServiceViewerApp::findForegroundEntityForPort(const PortEntry * aPort)
     ODL_P1("aPort = ", aPort); //####
     ServiceEntity * result = NULL;
     
-    for (EntityList::const_iterator it(_foregroundEntities->begin());
-         _foregroundEntities->end() != it; ++it)
+    // Each port is held by the panel of the entity that owns it.
+    if (aPort)
     {
-        ServiceEntity * anEntity = *it;
+        PortPanel * aPanel = aPort->getParent();
         
-        if (anEntity && anEntity->hasPort(aPort))
+        if (aPanel)
         {
-            result = anEntity;
-            break;
+            result = &aPanel->getContainer();
         }
-        
     }
     ODL_OBJEXIT_P(result); //####
     return result;
@@ -734,9 +1486,9 @@ ServiceViewerApp::findForegroundPort(const string & name)
     ODL_OBJENTER(); //####
     ODL_S1s("name = ", name); //####
     PortEntry *                  result;
-    PortEntryMap::const_iterator match(_foregroundPorts->find(name));
+    PortEntryMap::const_iterator match(_foregroundPorts.find(name));
     
-    if (_foregroundPorts->end() == match)
+    if (_foregroundPorts.end() == match)
     {
         result = NULL;
     }
@@ -755,22 +1507,69 @@ ServiceViewerApp::forgetPort(PortEntry * aPort)
     ODL_P1("aPort = ", aPort); //####
     if (aPort)
     {
-        PortEntryMap::iterator match(_foregroundPorts->find(aPort->getName()));
+        PortEntryMap::iterator match(_foregroundPorts.find(aPort->getPortName()));
         
-        if (_foregroundPorts->end() != match)
-        {
-            _foregroundPorts->erase(match);
-        }
-        match = _backgroundPorts->find(aPort->getName());
-        if (_backgroundPorts->end() != match)
+        if ((_foregroundPorts.end() != match) && (aPort == match->second))
         {
-            _backgroundPorts->erase(match);
+            _foregroundPorts.erase(match);
         }
     }
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::forgetPort
 
-void
+bool
+ServiceViewerApp::gatherConnectionsInBackground(MplusM::Common::CheckFunction checker,
+                                                void *                        checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("checkStuff = ", checkStuff); //####
+    ScanSnapshot &                latestData = _scanBuffer.getWriteSnapshot();
+    const ScanSnapshot::PortSet & knownPorts = _previousScan.getRememberedPorts();
+    MplusM::Utilities::PortVector knownPortList;
+    unsigned long long            scanStartTime = ScanStatistics::getTime();
+    bool                          changed = false;
+    
+    _scanSource->beginConnectionCheck();
+    // Everything but the connections is taken from the previous full scan.
+    latestData.assign(_previousScan);
+    latestData.getConnections().clear();
+    for (ScanSnapshot::PortSet::const_iterator walker(knownPorts.begin());
+         knownPorts.end() != walker; ++walker)
+    {
+        MplusM::Utilities::PortDescriptor aPort;
+        
+        aPort._portName = walker->c_str();
+        knownPortList.push_back(aPort);
+    }
+    addPortConnectionsToBackground(knownPortList, checker, checkStuff);
+    _statistics.record(ScanStatistics::kMeasurementConnectionsScan, scanStartTime);
+    if (! (checker && checker(checkStuff)))
+    {
+        ScanSnapshot::Delta delta;
+        
+        latestData.computeDelta(_previousScan, delta);
+        changed = (! delta.isEmpty());
+    }
+    if (changed)
+    {
+        _previousScan.assign(latestData);
+        if (_changeFeed)
+        {
+            _changeFeed->report(latestData);
+        }
+        // Make the results available to the display.
+        _scanBuffer.publish();
+    }
+    else
+    {
+        // There is nothing new for the display, so the scan is discarded.
+        latestData.clear();
+    }
+    ODL_OBJEXIT_B(changed); //####
+    return changed;
+} // ServiceViewerApp::gatherConnectionsInBackground
+
+bool
 ServiceViewerApp::gatherEntitiesInBackground(MplusM::Common::CheckFunction checker,
                                              void *                        checkStuff)
 {
@@ -778,36 +1577,91 @@ ServiceViewerApp::gatherEntitiesInBackground(MplusM::Common::CheckFunction check
     ODL_P1("checkStuff = ", checkStuff); //####
     MplusM::Utilities::PortVector detectedPorts;
     MplusM::Common::StringVector  services;
-#if defined(CHECK_FOR_STALE_PORTS)
+    ScanSnapshot::PortSet &       rememberedPorts =
+                                            _scanBuffer.getWriteSnapshot().getRememberedPorts();
     float                         now = ofGetElapsedTimef();
-#endif // defined(CHECK_FOR_STALE_PORTS)
+    unsigned long long            scanStartTime = ScanStatistics::getTime();
+    unsigned long long            phaseStartTime;
+    bool                          changed = false;
     
     // Mark our utility ports as known.
-    _rememberedPorts.insert(lInputOnlyPortName);
-    _rememberedPorts.insert(lOutputOnlyPortName);
+    rememberedPorts.insert(lInputOnlyPortName);
+    rememberedPorts.insert(lOutputOnlyPortName);
 #if defined(CHECK_FOR_STALE_PORTS)
     if ((_lastStaleTime + kMinStaleInterval) <= now)
     {
-        MplusM::Utilities::RemoveStalePorts();
+        phaseStartTime = ScanStatistics::getTime();
+        _scanSource->removeStalePorts();
+        _statistics.record(ScanStatistics::kMeasurementRemoveStalePorts, phaseStartTime);
         _lastStaleTime = now;
     }
 #endif // defined(CHECK_FOR_STALE_PORTS)
-    MplusM::Utilities::GetDetectedPortList(detectedPorts);
-    MplusM::Utilities::GetServiceNames(services, true, checker, checkStuff);
+    phaseStartTime = ScanStatistics::getTime();
+    _scanSource->getDetectedPortList(detectedPorts);
+    _statistics.record(ScanStatistics::kMeasurementDetectPorts, phaseStartTime);
+    phaseStartTime = ScanStatistics::getTime();
+    _scanSource->getServiceNames(services, checker, checkStuff);
+    _statistics.record(ScanStatistics::kMeasurementServiceNames, phaseStartTime);
     // Record the services to be displayed.
-    addServicesToBackground(services, checker, checkStuff);
+    phaseStartTime = ScanStatistics::getTime();
+    addServicesToBackground(services, detectedPorts, checker, checkStuff);
+    _statistics.record(ScanStatistics::kMeasurementServices, phaseStartTime);
     // Record the ports that have associates.
-    if (MplusM::Utilities::CheckForRegistryService(detectedPorts))
+    if (_scanSource->checkForRegistryService(detectedPorts))
     {
+        phaseStartTime = ScanStatistics::getTime();
         addPortsWithAssociatesToBackground(detectedPorts, checker, checkStuff);
+        _statistics.record(ScanStatistics::kMeasurementAssociates, phaseStartTime);
     }
     // Record the ports that are standalone.
+    phaseStartTime = ScanStatistics::getTime();
     addRegularPortEntitiesToBackground(detectedPorts, checker, checkStuff);
+    _statistics.record(ScanStatistics::kMeasurementStandalonePorts, phaseStartTime);
     // Record the port connections.
+    phaseStartTime = ScanStatistics::getTime();
     addPortConnectionsToBackground(detectedPorts, checker, checkStuff);
-    ODL_OBJEXIT(); //####
+    _statistics.record(ScanStatistics::kMeasurementConnections, phaseStartTime);
+    _statistics.record(ScanStatistics::kMeasurementWholeScan, scanStartTime);
+    if ((_lastStatisticsSaveTime + kStatisticsSaveInterval) <= now)
+    {
+        if (! _statistics.save(ofToDataPath(STATISTICS_FILE)))
+        {
+            ODL_LOG("(! _statistics.save(ofToDataPath(STATISTICS_FILE)))"); //####
+        }
+        _lastStatisticsSaveTime = now;
+    }
+    // Report the changes, unless the scan was cut short and is incomplete.
+    if (! (checker && checker(checkStuff)))
+    {
+        ScanSnapshot &      latestData = _scanBuffer.getWriteSnapshot();
+        ScanSnapshot::Delta delta;
+        
+        latestData.computeDelta(_previousScan, delta);
+        changed = (! delta.isEmpty());
+        _previousScan.assign(latestData);
+        if (_changeFeed)
+        {
+            _changeFeed->report(latestData);
+        }
+    }
+    // Make the results available to the display.
+    _scanBuffer.publish();
+    ODL_OBJEXIT_B(changed); //####
+    return changed;
 } // ServiceViewerApp::gatherEntitiesInBackground
 
+ofRectangle
+ServiceViewerApp::getViewBounds(void)
+const
+{
+    ODL_OBJENTER(); //####
+    ofRectangle result(_viewOrigin.x, _viewOrigin.y, ofGetWidth() / _viewScale,
+                       ofGetHeight() / _viewScale);
+    
+    ODL_OBJEXIT(); //####
+    return result;
+} // ServiceViewerApp::getViewBounds
+
 void
 ServiceViewerApp::gotMessage(ofMessage msg)
 {
@@ -841,6 +1695,39 @@ ServiceViewerApp::keyPressed(int key)
     {
         _shiftActive = true;
     }
+    if (('s' == key) || ('S' == key))
+    {
+        _statisticsVisible = (! _statisticsVisible);
+    }
+    else if (('+' == key) || ('=' == key))
+    {
+        zoomView(kViewScaleStep);
+    }
+    else if (('-' == key) || ('_' == key))
+    {
+        zoomView(1 / kViewScaleStep);
+    }
+    else if ('0' == key)
+    {
+        _viewOrigin.set(0, 0);
+        _viewScale = 1;
+    }
+    else if (OF_KEY_LEFT == key)
+    {
+        _viewOrigin.x -= (kPanStep / _viewScale);
+    }
+    else if (OF_KEY_RIGHT == key)
+    {
+        _viewOrigin.x += (kPanStep / _viewScale);
+    }
+    else if (OF_KEY_UP == key)
+    {
+        _viewOrigin.y -= (kPanStep / _viewScale);
+    }
+    else if (OF_KEY_DOWN == key)
+    {
+        _viewOrigin.y += (kPanStep / _viewScale);
+    }
     inherited::keyPressed(key);
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::keyPressed
@@ -877,7 +1764,44 @@ ServiceViewerApp::mouseDragged(int x,
 {
     ODL_OBJENTER(); //####
     ODL_L3("x = ", x, "y = ", y, "button = ", button); //####
+    ofPoint          where(screenToWorld(x, y));
+    ofMouseEventArgs args(makeMouseEventArgs(where, button));
+    bool             handled = false;
+    
     inherited::mouseDragged(x, y, button);
+    // The entity that was pressed keeps the drag, even when the mouse leaves it.
+    if (_mouseTarget)
+    {
+        ofPoint oldPosition(_mouseTarget->getShape().getTopLeft());
+        
+        handled = _mouseTarget->mouseDragged(args);
+        // An entity that the user has moved is no longer waiting for a layout, so that a layout
+        // that is still being calculated does not move it again.
+        if ((! _unplacedKeys.empty()) && (oldPosition != _mouseTarget->getShape().getTopLeft()))
+        {
+            for (std::set<string>::iterator it(_unplacedKeys.begin()); _unplacedKeys.end() != it;
+                 ++it)
+            {
+                EntityMap::const_iterator match(_entityMap.find(*it));
+                
+                if ((_entityMap.end() != match) && (_mouseTarget == match->second))
+                {
+                    _unplacedKeys.erase(it);
+                    break;
+                }
+            }
+        }
+    }
+    else if (_panActive)
+    {
+        // Move the display so that the position that was pressed stays under the mouse.
+        _viewOrigin = _panAnchor - (ofPoint(x, y) / _viewScale);
+        handled = true;
+    }
+    if ((! handled) && _addIsActive)
+    {
+        reportConnectionDrag(where.x, where.y);
+    }
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::mouseDragged
 
@@ -887,7 +1811,16 @@ ServiceViewerApp::mouseMoved(int x,
 {
     ODL_OBJENTER(); //####
     ODL_L2("x = ", x, "y = ", y); //####
+    ofPoint         where(screenToWorld(x, y));
+    ServiceEntity * anEntity = _entityGrid.findEntity(where.x, where.y);
+    
     inherited::mouseMoved(x, y);
+    if (anEntity)
+    {
+        ofMouseEventArgs args(makeMouseEventArgs(where, 0));
+        
+        anEntity->mouseMoved(args);
+    }
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::mouseMoved
 
@@ -898,8 +1831,28 @@ ServiceViewerApp::mousePressed(int x,
 {
     ODL_OBJENTER(); //####
     ODL_L3("x = ", x, "y = ", y, "button = ", button); //####
+    ofPoint where(screenToWorld(x, y));
+    bool    handled = false;
+    
     inherited::mousePressed(x, y, button);
-    reportPortEntryClicked(NULL);
+    // Only the topmost entity under the mouse sees the press.
+    _mouseTarget = _entityGrid.findEntity(where.x, where.y);
+    if (_mouseTarget)
+    {
+        ofMouseEventArgs args(makeMouseEventArgs(where, button));
+        
+        handled = _mouseTarget->mousePressed(args);
+    }
+    else
+    {
+        // A press outside of all the entities starts a pan of the display.
+        _panActive = true;
+        _panAnchor = where;
+    }
+    if (! handled)
+    {
+        reportPortEntryClicked(NULL);
+    }
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::mousePressed
 
@@ -910,8 +1863,29 @@ ServiceViewerApp::mouseReleased(int x,
 {
     ODL_OBJENTER(); //####
     ODL_L3("x = ", x, "y = ", y, "button = ", button); //####
+    ofPoint          where(screenToWorld(x, y));
+    ofMouseEventArgs args(makeMouseEventArgs(where, button));
+    ServiceEntity *  anEntity = _entityGrid.findEntity(where.x, where.y);
+    ServiceEntity *  pressedEntity = _mouseTarget;
+    bool             handled = false;
+    
     inherited::mouseReleased(x, y, button);
-    clearDragState();
+    _mouseTarget = NULL;
+    _panActive = false;
+    // The entity that was pressed is told first, so that it can finish a move, and then the
+    // entity under the mouse, which may be the end of a new connection.
+    if (pressedEntity)
+    {
+        handled = pressedEntity->mouseReleased(args);
+    }
+    if ((! handled) && anEntity && (anEntity != pressedEntity))
+    {
+        handled = anEntity->mouseReleased(args);
+    }
+    if (! handled)
+    {
+        clearDragState();
+    }
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::mouseReleased
 
@@ -922,13 +1896,13 @@ ServiceViewerApp::moveEntityToEndOfForegroundList(ServiceEntity * anEntity)
     ODL_P1("anEntity = ", anEntity); //####
     if (anEntity->isSelected())
     {
-        EntityList::iterator it(_foregroundEntities->begin());
+        EntityList::iterator it(_foregroundEntities.begin());
         
-        for ( ; _foregroundEntities->end() != it; ++it)
+        for ( ; _foregroundEntities.end() != it; ++it)
         {
             if (anEntity == *it)
             {
-                _foregroundEntities->erase(it);
+                _foregroundEntities.erase(it);
                 addEntityToForeground(anEntity);
                 break;
             }
@@ -940,16 +1914,58 @@ ServiceViewerApp::moveEntityToEndOfForegroundList(ServiceEntity * anEntity)
 } // ServiceViewerApp::moveEntityToEndOfForegroundList
 
 void
-ServiceViewerApp::rememberPortInBackground(PortEntry * aPort)
+ServiceViewerApp::rememberPortInForeground(PortEntry * aPort)
 {
     ODL_OBJENTER(); //####
     ODL_P1("aPort = ", aPort); //####
     if (aPort)
     {
-        _backgroundPorts->insert(PortEntryMap::value_type(static_cast<string> (*aPort), aPort));
+        _foregroundPorts.insert(PortEntryMap::value_type(aPort->getPortName(), aPort));
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::rememberPortInForeground
+
+void
+ServiceViewerApp::removeForegroundEntity(const string & key,
+                                         PositionMap &  positions)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("key = ", key); //####
+    ODL_P1("positions = ", &positions); //####
+    EntityMap::iterator match(_entityMap.find(key));
+    
+    if (_entityMap.end() != match)
+    {
+        ServiceEntity * anEntity = match->second;
+        
+        _entityMap.erase(match);
+        _unplacedKeys.erase(key);
+        if (anEntity)
+        {
+            ofRectangle shape(anEntity->getShape());
+            
+            positions[key] = ofPoint(shape.getX(), shape.getY());
+            for (EntityList::iterator it(_foregroundEntities.begin());
+                 _foregroundEntities.end() != it; ++it)
+            {
+                if (anEntity == *it)
+                {
+                    _foregroundEntities.erase(it);
+                    break;
+                }
+                
+            }
+            _entityGrid.remove(anEntity);
+            if (_mouseTarget == anEntity)
+            {
+                _mouseTarget = NULL;
+            }
+            // Note that the ports will be forgotten by the deletion of the entity.
+            delete anEntity;
+        }
     }
     ODL_OBJEXIT(); //####
-} // ServiceViewerApp::rememberPortInBackground
+} // ServiceViewerApp::removeForegroundEntity
 
 void
 ServiceViewerApp::reportConnectionDrag(const float xPos,
@@ -993,11 +2009,13 @@ ServiceViewerApp::reportPortEntryClicked(PortEntry * aPort)
                     
                     if (firstEntity && secondEntity)
                     {
-                    if (MplusM::Utilities::RemoveConnection(firstName.c_str(),
-                                                            aPort->getPortName().c_str()))
+                        if (_scanSource->removeConnection(firstName.c_str(),
+                                                          aPort->getPortName().c_str()))
                         {
                             _firstRemovePort->removeOutputConnection(aPort);
                             aPort->removeInputConnection(_firstRemovePort);
+                            _connectionRenderer.invalidate();
+                            requestImmediateScan();
                         }
                     }
                 }
@@ -1027,10 +2045,9 @@ ServiceViewerApp::reportPortEntryClicked(PortEntry * aPort)
                     
                     if (firstEntity && secondEntity)
                     {
-                        if (MplusM::Utilities::AddConnection(firstName.c_str(),
-                                                             aPort->getPortName().c_str(),
-                                                             STANDARD_WAIT_TIME,
-                                                             _addingUDPConnection))
+                        if (_scanSource->addConnection(firstName.c_str(),
+                                                       aPort->getPortName().c_str(),
+                                                       _addingUDPConnection))
                         {
                             MplusM::Common::ChannelMode mode = (_addingUDPConnection ?
                                                                 MplusM::Common::kChannelModeUDP :
@@ -1038,6 +2055,8 @@ ServiceViewerApp::reportPortEntryClicked(PortEntry * aPort)
                             
                             _firstAddPort->addOutputConnection(aPort, mode);
                             aPort->addInputConnection(_firstAddPort, mode);
+                            _connectionRenderer.invalidate();
+                            requestImmediateScan();
                         }
                     }
                 }
@@ -1128,149 +2147,283 @@ ServiceViewerApp::reportPortEntryClicked(PortEntry * aPort)
 } // ServiceViewerApp::reportPortEntryClicked
 
 void
-ServiceViewerApp::setEntityPositions(void)
+ServiceViewerApp::requestImmediateScan(void)
 {
     ODL_OBJENTER(); //####
-    bool                  positionsNeedUpdate = false;
-    float                 fullHeight = ofGetHeight();
-    float                 fullWidth = ofGetWidth();
-    ogdf::Graph           gg;
-    ogdf::GraphAttributes ga(gg);
-    ogdf::node            phantomNode = gg.newNode();
-    
-    ga.directed(true);
-    // If nodes are not connected, OGDF will pile them all at the origin; by adding a 'phantom' node
-    // that is connected to every other node, we force OGDF to spread the nodes out.
-    ga.width(phantomNode) = 1;
-    ga.height(phantomNode) = 1;
-    ga.x(phantomNode) = ofRandom(fullWidth);
-    ga.y(phantomNode) = ofRandom(fullHeight);
-    for (EntityList::const_iterator it(_backgroundEntities->begin());
-         _backgroundEntities->end() != it; ++it)
+    if (_scanner)
     {
-        ServiceEntity * anEntity = *it;
+        _scanner->requestImmediateScan();
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::requestImmediateScan
+
+bool
+ServiceViewerApp::runBenchmark(BenchmarkRunner & runner,
+                               const int         iterations)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("runner = ", &runner); //####
+    ODL_L1("iterations = ", iterations); //####
+    bool result = setUpScanning();
+    
+    if (result)
+    {
+        _layoutWorker->startThread(false, false); // non-blocking, non-verbose
+    }
+    for (int ii = 0; result && (iterations > ii); ++ii)
+    {
+        bool               changed;
+        unsigned long long startTime;
+        unsigned long long startAllocations;
         
-        if (anEntity)
+        // Each run starts from an empty display and nothing remembered from the previous run, so
+        // that all of the entities are built and all of the services are asked for their
+        // descriptors.
+        clearForeground();
+        _previousScan.clear();
+        _descriptorCache.clear();
+        startTime = ScanStatistics::getTime();
+        startAllocations = BenchmarkRunner::GetAllocationCount();
+        gatherEntitiesInBackground();
+        runner.record(BenchmarkRunner::kStageScan, startTime, startAllocations);
+        startTime = ScanStatistics::getTime();
+        startAllocations = BenchmarkRunner::GetAllocationCount();
+        changed = applyLatestScan();
+        runner.record(BenchmarkRunner::kStageBuild, startTime, startAllocations);
+        if (changed)
         {
-            float           newX;
-            float           newY;
-            ofRectangle     entityShape(anEntity->getShape());
-            ogdf::node      aNode = gg.newNode();
-            PortEntry *     firstPort = anEntity->getPort(0);
-            ServiceEntity * olderVersion;
-            
-            if (firstPort)
+            // The layout of the newly-built entities is not the one being measured, since it
+            // overlaps the build.
+            waitForLayout(kBenchmarkLayoutTimeout);
+        }
+        startTime = ScanStatistics::getTime();
+        startAllocations = BenchmarkRunner::GetAllocationCount();
+        setEntityPositions(_foregroundEntities);
+        if (waitForLayout(kBenchmarkLayoutTimeout))
+        {
+            runner.record(BenchmarkRunner::kStageLayout, startTime, startAllocations);
+        }
+        else
+        {
+            ODL_LOG("! (waitForLayout(kBenchmarkLayoutTimeout))"); //####
+            result = false;
+        }
+        if (result)
+        {
+            startTime = ScanStatistics::getTime();
+            startAllocations = BenchmarkRunner::GetAllocationCount();
+            draw();
+            // Drawing is not complete until the GL commands have been executed.
+            glFinish();
+            runner.record(BenchmarkRunner::kStageDraw, startTime, startAllocations);
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ServiceViewerApp::runBenchmark
+
+bool
+ServiceViewerApp::runHeadless(const string &                outputPath,
+                              const float                   scanInterval,
+                              const bool                    scanOnce,
+                              MplusM::Common::CheckFunction checker,
+                              void *                        checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("outputPath = ", outputPath); //####
+    ODL_D1("scanInterval = ", scanInterval); //####
+    ODL_B1("scanOnce = ", scanOnce); //####
+    ODL_P1("checkStuff = ", checkStuff); //####
+    bool result = setUpScanning();
+    
+    for (bool keepGoing = result; keepGoing; )
+    {
+        float scanStart = ofGetElapsedTimef();
+        
+        gatherEntitiesInBackground(checker, checkStuff);
+        if (checker && checker(checkStuff))
+        {
+            // The scan was cut short, so it isn't worth reporting.
+            keepGoing = false;
+        }
+        else
+        {
+            if (_scanBuffer.takeLatest() && (! writeLatestScan(outputPath)))
             {
-                olderVersion = findForegroundEntityForPort(firstPort->getPortName());
+                ODL_LOG("(_scanBuffer.takeLatest() && (! writeLatestScan(outputPath)))"); //####
+                result = keepGoing = false;
             }
-            else
+            else if (scanOnce)
             {
-                olderVersion = findForegroundEntity(anEntity->getName());
+                keepGoing = false;
             }
-            ga.width(aNode) = entityShape.width;
-            ga.height(aNode) = entityShape.height;
-            anEntity->setNode(aNode);
-            if (olderVersion)
+        }
+        // Wait for the next scan, while watching for a request to stop.
+        while (keepGoing && ((scanStart + scanInterval) > ofGetElapsedTimef()))
+        {
+            if (checker && checker(checkStuff))
             {
-                ofRectangle oldShape(olderVersion->getShape());
-                
-                newX = oldShape.getX();
-                newY = oldShape.getY();
+                keepGoing = false;
             }
             else
             {
-                newX = ofRandom(fullWidth - entityShape.width);
-                newY = ofRandom(fullHeight - entityShape.height);
-                positionsNeedUpdate = true;
+                ofSleepMillis(kHeadlessPollInterval);
             }
-            ga.x(aNode) = newX;
-            ga.y(aNode) = newY;
-            anEntity->setPosition(newX, newY);
         }
     }
-    if (positionsNeedUpdate)
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ServiceViewerApp::runHeadless
+
+ofPoint
+ServiceViewerApp::screenToWorld(const int x,
+                                const int y)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_L2("x = ", x, "y = ", y); //####
+    ofPoint result(_viewOrigin + (ofPoint(x, y) / _viewScale));
+    
+    ODL_OBJEXIT(); //####
+    return result;
+} // ServiceViewerApp::screenToWorld
+
+void
+ServiceViewerApp::setChangeFeed(const string & destination)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("destination = ", destination); //####
+    if (_changeFeed)
+    {
+        delete _changeFeed;
+    }
+    _changeFeed = new ChangeFeed(destination);
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::setChangeFeed
+
+void
+ServiceViewerApp::setScanSource(ScanSource * source)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("source = ", source); //####
+    if (source)
+    {
+        delete _scanSource;
+        _scanSource = source;
+    }
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::setScanSource
+
+void
+ServiceViewerApp::setEntityPositions(const EntityList & newEntities)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("newEntities = ", &newEntities); //####
+    ofRectangle                 viewBounds(getViewBounds());
+    NodeIndexMap                nodeIndices;
+    EdgeWeightMap               edgeWeights;
+    std::set<ServiceEntity *>   unplacedEntities(newEntities.begin(), newEntities.end());
+    LayoutWorker::LayoutRequest request;
+    
+    // Give the new entities a random starting position within the visible part of the display; the
+    // existing entities stay where they are.
+    for (EntityList::const_iterator it(newEntities.begin()); newEntities.end() != it; ++it)
+    {
+        ServiceEntity * anEntity = *it;
+        
+        if (anEntity)
+        {
+            ofRectangle entityShape(anEntity->getShape());
+            
+            anEntity->setPosition(viewBounds.x +
+                                  ofRandom(std::max(0.0f, viewBounds.width - entityShape.width)),
+                                  viewBounds.y +
+                                  ofRandom(std::max(0.0f, viewBounds.height - entityShape.height)));
+        }
+    }
+    request._viewOrigin.set(viewBounds.x, viewBounds.y);
+    request._fullWidth = viewBounds.width;
+    request._fullHeight = viewBounds.height;
+    request._nodes.reserve(_entityMap.size());
+    for (EntityMap::const_iterator it(_entityMap.begin()); _entityMap.end() != it; ++it)
     {
-        // Set up the edges (connections)
-        for (EntityList::const_iterator it(_backgroundEntities->begin());
-             _backgroundEntities->end() != it; ++it)
+        ServiceEntity * anEntity = it->second;
+        
+        if (anEntity)
         {
-            ServiceEntity * anEntity = *it;
+            ofRectangle              entityShape(anEntity->getShape());
+            LayoutWorker::LayoutNode aNode;
+            
+            aNode._key = it->first;
+            aNode._x = entityShape.getX();
+            aNode._y = entityShape.getY();
+            aNode._width = entityShape.width;
+            aNode._height = entityShape.height;
+            // Entities that have been laid out, including those placed by the user, stay where they
+            // are. The entities of an earlier request are still unplaced if that request was
+            // replaced before its layout was applied.
+            if (unplacedEntities.end() != unplacedEntities.find(anEntity))
+            {
+                _unplacedKeys.insert(it->first);
+            }
+            aNode._pinned = (_unplacedKeys.end() == _unplacedKeys.find(it->first));
+            nodeIndices[anEntity] = request._nodes.size();
+            request._nodes.push_back(aNode);
+        }
+    }
+    // Set up the edges (connections), with one edge for each pair of connected entities.
+    for (NodeIndexMap::const_iterator it(nodeIndices.begin());
+         nodeIndices.end() != it; ++it)
+    {
+        ServiceEntity * anEntity = it->first;
+        
+        // Add edges between entities that are connected via their entries
+        for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+        {
+            PortEntry * aPort = anEntity->getPort(ii);
             
-            if (anEntity)
+            if (aPort)
             {
-                bool       wasConnected = false;
-                ogdf::node thisNode = anEntity->getNode();
+                const PortEntry::Connections & outputs(aPort->getOutputConnections());
                 
-                // Add edges between entities that are connected via their entries
-                for (int ii = 0, mm = anEntity->getNumPorts(); mm > ii; ++ii)
+                for (int jj = 0, nn = outputs.size(); nn > jj; ++jj)
                 {
-                    PortEntry * aPort = anEntity->getPort(ii);
+                    PortEntry * otherPort = outputs[jj]._otherPort;
                     
-                    if (aPort)
+                    if (otherPort)
                     {
-                        const PortEntry::Connections & outputs(aPort->getOutputConnections());
+                        PortPanel * otherParent = otherPort->getParent();
                         
-                        for (int jj = 0, nn = outputs.size(); nn > jj; ++jj)
+                        if (otherParent)
                         {
-                            PortEntry * otherPort = outputs[jj]._otherPort;
+                            ServiceEntity &              otherEntity = otherParent->getContainer();
+                            NodeIndexMap::const_iterator match(nodeIndices.find(&otherEntity));
                             
-                            if (otherPort)
+                            if ((nodeIndices.end() != match) && (it->second != match->second))
                             {
-                                PortPanel * otherParent = otherPort->getParent();
-                                
-                                if (otherParent)
-                                {
-                                    ServiceEntity & otherEntity = otherParent->getContainer();
-                                    ogdf::node      otherNode = otherEntity.getNode();
-                                    /*ogdf::edge      ee =*/ gg.newEdge(thisNode, otherNode);
-                                    
-                                    wasConnected = true;
-                                }
+                                ++edgeWeights[std::make_pair(std::min(it->second, match->second),
+                                                             std::max(it->second,
+                                                                      match->second))];
                             }
                         }
-                        const PortEntry::Connections & inputs(aPort->getInputConnections());
-                        
-                        if (0 < inputs.size())
-                        {
-                            wasConnected = true;
-                        }
                     }
                 }
-                if (! wasConnected)
-                {
-                    /*ogdf::edge phantomNodeToThis =*/ gg.newEdge(phantomNode, thisNode);
-
-                }
             }
         }
-        // Apply an energy-based layout
-        ogdf::FMMMLayout fmmm;
+    }
+    request._edges.reserve(edgeWeights.size());
+    for (EdgeWeightMap::const_iterator it(edgeWeights.begin()); edgeWeights.end() != it; ++it)
+    {
+        LayoutWorker::LayoutEdge anEdge;
         
-        fmmm.useHighLevelOptions(true);
-        fmmm.newInitialPlacement(false); //true);
-        fmmm.qualityVersusSpeed(ogdf::FMMMLayout::qvsGorgeousAndEfficient);
-        fmmm.allowedPositions(ogdf::FMMMLayout::apAll);
-        fmmm.initialPlacementMult(ogdf::FMMMLayout::ipmAdvanced);
-        fmmm.initialPlacementForces(ogdf::FMMMLayout::ipfKeepPositions);
-        fmmm.repForcesStrength(2.0);
-        fmmm.call(ga);
-        for (EntityList::const_iterator it(_backgroundEntities->begin());
-             _backgroundEntities->end() != it; ++it)
-        {
-            ServiceEntity * anEntity = *it;
-            
-            if (anEntity)
-            {
-                ogdf::node aNode = anEntity->getNode();
-                
-                if (aNode)
-                {
-                    anEntity->setPosition(ga.x(aNode), ga.y(aNode));
-                }
-            }
-        }
+        anEdge._from = it->first.first;
+        anEdge._to = it->first.second;
+        anEdge._weight = it->second;
+        request._edges.push_back(anEdge);
     }
-    gg.clear();
+    // The energy-based layout is applied by the layout thread, and the results are picked up in
+    // update().
+    _layoutWorker->requestLayout(request);
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::setEntityPositions
 
@@ -1281,222 +2434,83 @@ ServiceViewerApp::setup(void)
     ofSetWindowTitle("Service Viewer");
     ofSetFrameRate(60);
     ofSetVerticalSync(true);
-    MplusM::Utilities::SetUpGlobalStatusReporter();
-    MplusM::Utilities::CheckForNameServerReporter();
-#if CheckNetworkWorks_
-    if (yarp::os::Network::checkNetwork(NETWORK_CHECK_TIMEOUT))
-#endif // CheckNetworkWorks_
+    if (setUpScanning())
     {
-        _networkAvailable = true;
-        createDirectionTestPorts();
+        _layoutWorker->startThread(false, false); // non-blocking, non-verbose
         _scanner->startThread(false, false); // non-blocking, non-verbose
         _scanner->enableScan();
     }
-#if CheckNetworkWorks_
-    else
-    {
-        ODL_LOG("! (yarp::os::Network::checkNetwork())"); //####
-# if MAC_OR_LINUX_
-        yarp::os::impl::Logger & theLogger = MplusM::Common::GetLogger();
-        
-        theLogger.fail("YARP network not running.");
-# endif // MAC_OR_LINUX_
-        _networkAvailable = false;
-    }
-#endif // CheckNetworkWorks_
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::setup
 
-void
-ServiceViewerApp::swapBackgroundAndForeground(void)
+bool
+ServiceViewerApp::setUpScanning(void)
 {
     ODL_OBJENTER(); //####
-    if ((! _firstAddPort) && (! _firstRemovePort) && (! _movementActive))
+    _networkAvailable = _scanSource->start();
+    // The directions of the ports of a generated network are already known.
+    if (_networkAvailable && _scanSource->requiresDirectionProbing())
     {
-        _foregroundLock.lock();
-        swap(_backgroundPorts, _foregroundPorts);
-        swap(_backgroundEntities, _foregroundEntities);
-        _foregroundLock.unlock();
+        if (! _directionCache.load(ofToDataPath(DIRECTION_CACHE_FILE)))
+        {
+            ODL_LOG("(! _directionCache.load(ofToDataPath(DIRECTION_CACHE_FILE)))"); //####
+        }
+        createDirectionTestPorts();
     }
-    ODL_OBJEXIT(); //####
-} // ServiceViewerApp::swapBackgroundAndForeground
+    ODL_OBJEXIT_B(_networkAvailable); //####
+    return _networkAvailable;
+} // ServiceViewerApp::setUpScanning
 
 void
 ServiceViewerApp::update(void)
 {
     ODL_OBJENTER(); //####
     inherited::update();
-    if (_scanner)
+    // Scan results and layouts are held until there is no GUI activity, so that the entities being
+    // worked with don't vanish or jump.
+    if ((! _firstAddPort) && (! _firstRemovePort) && (! _movementActive))
     {
-        for (bool locked = _scanner->lock(); ! locked; locked = _scanner->lock())
-        {
-            sleep(SHORT_SLEEP);
-        }
-        bool scanDataReady = _scanner->scanComplete();
+        LayoutWorker::PositionMap newPositions;
         
-        _scanner->unlock();
-        if (scanDataReady)
+        applyLatestScan();
+        if (_layoutWorker->fetchResults(newPositions))
         {
-            if (_firstAddPort || _firstRemovePort || _movementActive)
-            {
-                _ignoreNextScan = true;
-            }
-            else if (_ignoreNextScan)
-            {
-                _ignoreNextScan = false;
-            }
-            else
-            {
-                // We have no GUI activity, so we can use the results of the scan. Convert the
-                // detected services into entities in the background list.
-                for (ServiceMap::const_iterator outer(_detectedServices.begin());
-                     _detectedServices.end() != outer; ++outer)
-                {
-                    MplusM::Utilities::ServiceDescriptor descriptor(outer->second);
-                    ServiceEntity *                      anEntity =
-                                                    new ServiceEntity(PortPanel::kEntityKindService,
-                                                                      descriptor._kind.c_str(),
-                                                                  descriptor._description.c_str(),
-                                                                      *this);
-                    
-                    anEntity->setup(descriptor._serviceName);
-                    PortEntry * aPort = anEntity->addPort(descriptor._channelName, "",
-                                                          PortEntry::kPortUsageService,
-                                                          PortEntry::kPortDirectionInput);
-
-                    if (aPort)
-                    {
-                        rememberPortInBackground(aPort);
-                    }
-                    for (MplusM::Common::ChannelVector::const_iterator inner =
-                                                                descriptor._inputChannels.begin();
-                         descriptor._inputChannels.end() != inner; ++inner)
-                    {
-                        MplusM::Common::ChannelDescription aChannel(*inner);
-                        
-                        aPort = anEntity->addPort(aChannel._portName, aChannel._portProtocol,
-                                                  PortEntry::kPortUsageInputOutput,
-                                                  PortEntry::kPortDirectionInput);
-                        if (aPort)
-                        {
-                            rememberPortInBackground(aPort);
-                        }
-                    }
-                    for (MplusM::Common::ChannelVector::const_iterator inner =
-                                                                descriptor._outputChannels.begin();
-                         descriptor._outputChannels.end() != inner; ++inner)
-                    {
-                        MplusM::Common::ChannelDescription aChannel(*inner);
-                        
-                        aPort = anEntity->addPort(aChannel._portName, aChannel._portProtocol,
-                                                  PortEntry::kPortUsageInputOutput,
-                                                  PortEntry::kPortDirectionOutput);
-                        if (aPort)
-                        {
-                            rememberPortInBackground(aPort);
-                        }
-                    }
-                    addEntityToBackground(anEntity);
-                }
-                // Convert the detected ports with associates into entities in the background list.
-                for (AssociatesMap::const_iterator outer(_associatedPorts.begin());
-                     _associatedPorts.end() != outer; ++outer)
-                {
-                    PortEntry *                                aPort;
-                    ServiceEntity *                            anEntity =
-                                            new ServiceEntity(PortPanel::kEntityKindClientOrAdapter,
-                                                              "", "", *this);
-                    const MplusM::Utilities::PortAssociation & associates =
-                                                                        outer->second._associates;
-                    
-                    anEntity->setup(outer->first.c_str());
-                    for (MplusM::Common::StringVector::const_iterator inner =
-                                                                        associates._inputs.begin();
-                         associates._inputs.end() != inner; ++inner)
-                    {
-                        aPort = anEntity->addPort(*inner, "", PortEntry::kPortUsageOther,
-                                                  PortEntry::kPortDirectionInput);
-                        if (aPort)
-                        {
-                            rememberPortInBackground(aPort);
-                        }
-                    }
-                    for (MplusM::Common::StringVector::const_iterator inner =
-                                                                        associates._outputs.begin();
-                         associates._outputs.end() != inner; ++inner)
-                    {
-                        aPort = anEntity->addPort(*inner, "", PortEntry::kPortUsageOther,
-                                                  PortEntry::kPortDirectionOutput);
-                        if (aPort)
-                        {
-                            rememberPortInBackground(aPort);
-                        }
-                    }
-                    aPort = anEntity->addPort(outer->second._name, "", PortEntry::kPortUsageClient,
-                                              PortEntry::kPortDirectionInputOutput);
-                    if (aPort)
-                    {
-                        rememberPortInBackground(aPort);
-                    }
-                    addEntityToBackground(anEntity);
-                }
-                // Convert the detected standalone ports into entities in the background list.
-                for (PortMap::const_iterator walker(_standalonePorts.begin());
-                     _standalonePorts.end() != walker; ++walker)
-                {
-                    ServiceEntity *      anEntity = new ServiceEntity(PortPanel::kEntityKindOther,
-                                                                      "", "", *this);
-                    PortEntry::PortUsage usage;
-                    
-                    anEntity->setup(walker->first.c_str());
-                    switch (MplusM::Utilities::GetPortKind(walker->second._name))
-                    {
-                        case MplusM::Utilities::kPortKindClient :
-                            usage = PortEntry::kPortUsageClient;
-                            break;
-                            
-                        case MplusM::Utilities::kPortKindRegistryService :
-                        case MplusM::Utilities::kPortKindService :
-                            usage = PortEntry::kPortUsageService;
-                            break;
-                            
-                        default :
-                            usage = PortEntry::kPortUsageOther;
-                            break;
-                            
-                    }
-                    PortEntry * aPort = anEntity->addPort(walker->second._name, "", usage,
-                                                          walker->second._direction);
-                    
-                    if (aPort)
-                    {
-                        rememberPortInBackground(aPort);
-                    }
-                    addEntityToBackground(anEntity);
-                }
-                // Convert the detected connections into connections in the background list.
-                for (ConnectionList::const_iterator walker(_connections.begin());
-                     _connections.end() != walker; ++walker)
-                {
-                    PortEntry * thisPort = findBackgroundPort(walker->_outPortName);
-                    PortEntry * otherPort = findBackgroundPort(walker->_inPortName);
-                    
-                    if (thisPort && otherPort)
-                    {
-                        thisPort->addOutputConnection(otherPort, walker->_mode);
-                        otherPort->addInputConnection(thisPort, walker->_mode);
-                    }
-                }
-                setEntityPositions();
-                swapBackgroundAndForeground();
-            }
-            clearOutBackgroundData();
-            _scanner->enableScan();
+            applyLayoutResults(newPositions);
         }
     }
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::update
 
+bool
+ServiceViewerApp::waitForLayout(const float timeout)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("timeout = ", timeout); //####
+    bool                      result = false;
+    float                     endTime = ofGetElapsedTimef() + timeout;
+    LayoutWorker::PositionMap newPositions;
+    
+    for (bool keepGoing = true; keepGoing; )
+    {
+        if (_layoutWorker->fetchResults(newPositions))
+        {
+            applyLayoutResults(newPositions);
+            result = true;
+            keepGoing = false;
+        }
+        else if (endTime <= ofGetElapsedTimef())
+        {
+            keepGoing = false;
+        }
+        else
+        {
+            ofSleepMillis(kBenchmarkPollInterval);
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ServiceViewerApp::waitForLayout
+
 void
 ServiceViewerApp::windowResized(int w,
                                 int h)
@@ -1507,6 +2521,59 @@ ServiceViewerApp::windowResized(int w,
     ODL_OBJEXIT(); //####
 } // ServiceViewerApp::windowResized
 
+bool
+ServiceViewerApp::writeLatestScan(const string & outputPath)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("outputPath = ", outputPath); //####
+    bool                 result = true;
+    const ScanSnapshot & latestData = _scanBuffer.getReadSnapshot();
+    
+    if (outputPath.empty())
+    {
+        latestData.writeAsJson(std::cout);
+        std::cout << std::endl;
+    }
+    else
+    {
+        // The scan is written to a temporary file, which then replaces the output file, so that
+        // anyone reading the output file never sees a partial scan.
+        string        tempPath(outputPath + ".tmp");
+        std::ofstream outFile(tempPath.c_str());
+        
+        if (outFile)
+        {
+            latestData.writeAsJson(outFile);
+            outFile << std::endl;
+            outFile.close();
+#if (! MAC_OR_LINUX_)
+            std::remove(outputPath.c_str());
+#endif // ! MAC_OR_LINUX_
+            result = (! outFile.fail()) && (0 == std::rename(tempPath.c_str(), outputPath.c_str()));
+        }
+        else
+        {
+            ODL_LOG("! (outFile)"); //####
+            result = false;
+        }
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // ServiceViewerApp::writeLatestScan
+
+void
+ServiceViewerApp::zoomView(const float factor)
+{
+    ODL_OBJENTER(); //####
+    ODL_D1("factor = ", factor); //####
+    ofPoint windowCentre(ofGetWidth() / 2, ofGetHeight() / 2);
+    ofPoint viewCentre(screenToWorld(windowCentre.x, windowCentre.y));
+    
+    _viewScale = std::max(kMinViewScale, std::min(kMaxViewScale, _viewScale * factor));
+    _viewOrigin = viewCentre - (windowCentre / _viewScale);
+    ODL_OBJEXIT(); //####
+} // ServiceViewerApp::zoomView
+
 #if defined(__APPLE__)
 # pragma mark Global functions
 #endif // defined(__APPLE__)
@@ -39,7 +39,14 @@
 #if (! defined(__ServiceViewer__ServiceViewerApp__))
 # define __ServiceViewer__ServiceViewerApp__  /* Header guard */
 
+# include "ConnectionRenderer.h"
+# include "EntityGrid.h"
+# include "LayoutWorker.h"
+# include "PortDirectionCache.h"
 # include "PortEntry.h"
+# include "ScanSnapshotBuffer.h"
+# include "ScanStatistics.h"
+# include "ServiceDescriptorCache.h"
 
 # include "ofBaseApp.h"
 # include "ofxGui.h"
@@ -49,6 +56,7 @@
 # include <mpm/M+MUtilities.h>
 
 # include <list>
+# include <set>
 
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
@@ -64,13 +72,11 @@
 
 //# define CHECK_FOR_STALE_PORTS /* Check for 'stale' ports in the scanner. */
 
-/*! @brief A slightly longer sleep, in milliseconds. */
-# define MIDDLE_SLEEP 35
-
-/*! @brief The minimum time for a thread to sleep, in milliseconds. */
-# define SHORT_SLEEP  20
-
 class BackgroundScanner;
+class BenchmarkRunner;
+class ChangeFeed;
+class ScanSource;
+class ScanWorkerPool;
 class ServiceEntity;
 
 /*! @brief The service viewer application class. */
@@ -81,11 +87,6 @@ public :
     /*! @brief The constructor. */
     ServiceViewerApp(void);
     
-    /*! @brief Add an entity to the list of next-to-be-displayed entities.
-     @param anEntity The entity to be added. */
-    void
-    addEntityToBackground(ServiceEntity * anEntity);
-    
     /*! @brief Add an entity to the list of currently displayed entities.
      @param anEntity The entity to be added. */
     void
@@ -104,10 +105,6 @@ public :
     void
     clearDragState(void);
     
-    /*! @brief Clear out the background data. */
-    void
-    clearOutBackgroundData(void);
-    
     /*! @brief Returns the state of the CONTROL modifier key.
      @returns @c true if the CONTROL modifier key is pressed and @c false otherwise. */
     inline bool
@@ -144,10 +141,21 @@ public :
     void
     forgetPort(PortEntry * aPort);
     
+    /*! @brief Check the connections between the ports found by the most recent full scan.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the connections have changed since the previous scan and @c false
+     otherwise. */
+    bool
+    gatherConnectionsInBackground(MplusM::Common::CheckFunction checker = NULL,
+                                  void *                        checkStuff = NULL);
+    
     /*! @brief Identify the YARP network entities.
      @param checker A function that provides for early exit from loops.
-     @param checkStuff The private data for the early exit function. */
-    void
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the entities have changed since the previous scan and @c false
+     otherwise. */
+    bool
     gatherEntitiesInBackground(MplusM::Common::CheckFunction checker = NULL,
                                void *                        checkStuff = NULL);
     
@@ -209,6 +217,7 @@ public :
     inline void
     movementStarted(void)
     {
+        _connectionRenderer.invalidate();
         _movementActive = true;
     } // movementStarted
     
@@ -233,6 +242,50 @@ public :
     void
     reportPortEntryClicked(PortEntry * aPort);
     
+    /*! @brief Have the background scanner start a scan as soon as possible, since the network
+     is known to have changed. */
+    void
+    requestImmediateScan(void);
+    
+    /*! @brief Scan the network, build the entities, lay them out and draw them repeatedly,
+     starting from an empty display each time, and record the time taken by each stage. Needs a
+     GL context but not a running application.
+     @param runner Where the time taken by each stage is recorded.
+     @param iterations The number of times that the stages are to be run.
+     @returns @c true if the network could be scanned and @c false otherwise. */
+    bool
+    runBenchmark(BenchmarkRunner & runner,
+                 const int         iterations);
+    
+    /*! @brief Scan the network repeatedly without a display, writing each scan as a single-line
+     JSON object.
+     @param outputPath The file to be replaced with each scan; if empty, each scan is written to
+     the standard output.
+     @param scanInterval The minimum time between scans, in seconds.
+     @param scanOnce @c true if only a single scan is to be done and @c false otherwise.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the network could be scanned and the scans written and @c false
+     otherwise. */
+    bool
+    runHeadless(const string &                outputPath,
+                const float                   scanInterval,
+                const bool                    scanOnce,
+                MplusM::Common::CheckFunction checker = NULL,
+                void *                        checkStuff = NULL);
+    
+    /*! @brief Publish the changes found by each scan. Must be called before scanning starts.
+     @param destination Where the changes are to be written; either a file or named pipe, or
+     'unix:' followed by the path of a listening local socket. */
+    void
+    setChangeFeed(const string & destination);
+    
+    /*! @brief Scan a different network than the live YARP network. Must be called before scanning
+     starts.
+     @param source The network to be scanned; the application takes ownership of it. */
+    void
+    setScanSource(ScanSource * source);
+    
     /*! @brief Setup the parameters of the application. */
     virtual void
     setup(void);
@@ -241,6 +294,15 @@ public :
     virtual void
     update(void);
     
+    /*! @brief Record the current bounding box of an entity, so that mouse events can be delivered
+     to it.
+     @param anEntity The entity that has been moved or resized. */
+    inline void
+    updateEntityBounds(ServiceEntity * anEntity)
+    {
+        _entityGrid.update(anEntity);
+    } // updateEntityBounds
+    
     /*! @brief Process a window-resized event.
      @param w The new window width.
      @param h The new window height. */
@@ -287,9 +349,26 @@ protected :
     
 private :
     
+    /*! @brief A collection of services and ports. */
+    typedef std::list<ServiceEntity *> EntityList;
+    
+    /*! @brief A mapping from keys to entity positions. */
+    typedef std::map<string, ofPoint> PositionMap;
+    
     COPY_AND_ASSIGNMENT_(ServiceViewerApp);
     
+    /*! @brief Create an entity for a port that has associates and add it to the currently
+     displayed list.
+     @param caption The IP address and port number of the port.
+     @param associates The port and its associates.
+     @returns The newly-created entity. */
+    ServiceEntity *
+    addAdapterEntity(const string &                          caption,
+                     const ScanSnapshot::PortAndAssociates & associates);
+    
     /*! @brief Add connections between detected ports in the to-be-displayed list.
+     
+     The connections of the ports are requested concurrently, using the pool of scan workers.
      @param detectedPorts The set of detected YARP ports.
      @param checker A function that provides for early exit from loops.
      @param checkStuff The private data for the early exit function. */
@@ -316,26 +395,61 @@ private :
                                        MplusM::Common::CheckFunction         checker = NULL,
                                        void *                                checkStuff = NULL);
     
+    /*! @brief Create an entity for a service and add it to the currently displayed list.
+     @param descriptor The description of the service.
+     @returns The newly-created entity. */
+    ServiceEntity *
+    addServiceEntity(const MplusM::Utilities::ServiceDescriptor & descriptor);
+    
     /*! @brief Add services as distinct entities to the to-be-displayed list.
+     
+     The descriptors of the services are requested concurrently, using the pool of scan workers.
+     Descriptors that were retrieved by earlier scans are reused, as long as the service has not
+     moved to a different network address.
      @param services The set of detected services.
+     @param detectedPorts The set of detected ports.
      @param checker A function that provides for early exit from loops.
      @param checkStuff The private data for the early exit function. */
     void
-    addServicesToBackground(const MplusM::Common::StringVector & services,
-                            MplusM::Common::CheckFunction        checker = NULL,
-                            void *                               checkStuff = NULL);
+    addServicesToBackground(const MplusM::Common::StringVector &  services,
+                            const MplusM::Utilities::PortVector & detectedPorts,
+                            MplusM::Common::CheckFunction         checker = NULL,
+                            void *                                checkStuff = NULL);
+    
+    /*! @brief Create an entity for a standalone port and add it to the currently displayed list.
+     @param caption The IP address and port number of the port.
+     @param info The name and direction of the port.
+     @returns The newly-created entity. */
+    ServiceEntity *
+    addStandalonePortEntity(const string &                         caption,
+                            const ScanSnapshot::NameAndDirection & info);
     
-    /*! @brief Find a port in the to-be-displayed list by name.
-     @param name The name of the port.
-     @returns @c NULL if the port cannot be found and non-@c NULL if it is found. */
-    PortEntry *
-    findBackgroundPort(const string & name);
+    /*! @brief Update the currently displayed entities to match the most recent scan, if there is
+     a newer one.
+     @returns @c true if the currently displayed entities were changed and @c false
+     otherwise. */
+    bool
+    applyLatestScan(void);
     
-    /*! @brief Find an entity in the currently-displayed list by name.
-     @param name The name of the entity.
-     @returns @c NULL if the entity cannot be found and non-@c NULL if it is found. */
-    ServiceEntity *
-    findForegroundEntity(const string & name);
+    /*! @brief Move the entities that are waiting for a layout to their calculated positions.
+     @param newPositions The calculated positions of the entities. */
+    void
+    applyLayoutResults(const LayoutWorker::PositionMap & newPositions);
+    
+    /*! @brief Update the currently displayed entities to match a newer scan.
+     @param newer The newer scan.
+     @param delta The differences between the currently displayed scan and the newer scan. */
+    void
+    applyScanDelta(const ScanSnapshot &        newer,
+                   const ScanSnapshot::Delta & delta);
+    
+    /*! @brief Remove and release all of the currently displayed entities. */
+    void
+    clearForeground(void);
+    
+    /*! @brief Display the scan statistics over the entities. */
+    void
+    drawStatistics(void);
     
     /*! @brief Find an entity by the name of a port within it.
      @param name The name of the port.
@@ -355,18 +469,60 @@ private :
     PortEntry *
     findForegroundPort(const string & name);
     
-    /*! @brief Add a port to the set of known ports in the to-be-displayed list.
+    /*! @brief Return the area of the display that is visible in the window.
+     @returns The area of the display that is visible in the window. */
+    ofRectangle
+    getViewBounds(void)
+    const;
+    
+    /*! @brief Add a port to the set of known ports in the currently displayed list.
      @param aPort The port to be added. */
     void
-    rememberPortInBackground(PortEntry * aPort);
+    rememberPortInForeground(PortEntry * aPort);
     
-    /*! @brief Set the entity positions. */
+    /*! @brief Remove an entity from the currently displayed list and release it.
+     @param key The key for the entity.
+     @param positions The positions of the removed entities. */
     void
-    setEntityPositions(void);
-    
-    /*! @brief Swap the background and foreground data structures. */
+    removeForegroundEntity(const string & key,
+                           PositionMap &  positions);
+    
+    /*! @brief Convert a position in the window to a position in the display.
+     @param x The horizontal position in the window.
+     @param y The vertical position in the window.
+     @returns The corresponding position in the display, after the current pan and zoom. */
+    ofPoint
+    screenToWorld(const int x,
+                  const int y)
+    const;
+    
+    /*! @brief Set the entity positions.
+     @param newEntities The entities that have not yet been positioned. */
+    void
+    setEntityPositions(const EntityList & newEntities);
+    
+    /*! @brief Prepare for scanning the network.
+     @returns @c true if the network is available and @c false otherwise. */
+    bool
+    setUpScanning(void);
+    
+    /*! @brief Wait for the layout thread to complete a layout and apply its results.
+     @param timeout The maximum time to wait, in seconds.
+     @returns @c true if a layout was applied and @c false if none was completed in time. */
+    bool
+    waitForLayout(const float timeout);
+    
+    /*! @brief Write the most recent scan.
+     @param outputPath The file to be replaced with the scan; if empty, the scan is written to the
+     standard output.
+     @returns @c true if the scan was written and @c false otherwise. */
+    bool
+    writeLatestScan(const string & outputPath);
+    
+    /*! @brief Change the scale of the display, keeping the centre of the window in place.
+     @param factor The amount by which to multiply the scale. */
     void
-    swapBackgroundAndForeground(void);
+    zoomView(const float factor);
     
 public :
 
@@ -377,104 +533,54 @@ private :
     /*! @brief The class that this class is derived from. */
     typedef ofBaseApp inherited;
     
-    /*! @brief The information for a connection. */
-    struct ConnectionDetails
-    {
-        /*! @brief The name of the destination port. */
-        string _inPortName;
-        
-        /*! @brief The name of the source port. */
-        string _outPortName;
-        
-        /*! @brief The mode of the connection. */
-        MplusM::Common::ChannelMode _mode;
-        
-    }; // ConnectionDetails
-    
-    /*! @brief The name and direction for a port. */
-    struct NameAndDirection
-    {
-        /*! @brief The name of the port. */
-        string _name;
-        
-        /*! @brief The direction of the port. */
-        PortEntry::PortDirection _direction;
-        
-    }; // NameAndDirection
-    
-    /*! @brief The name and associates for a port. */
-    struct PortAndAssociates
-    {
-        /*! @brief The name of the port. */
-        string _name;
-        
-        /*! @brief The associates of the port. */
-        MplusM::Utilities::PortAssociation _associates;
-        
-    }; // PortAndAssociates
-    
-    /*! @brief A mapping from port names to associates. */
-    typedef std::map<string, PortAndAssociates> AssociatesMap;
+    /*! @brief A mapping from pairs of layout node indices to the number of connections between
+     them. */
+    typedef std::map<std::pair<size_t, size_t>, int> EdgeWeightMap;
     
-    /*! @brief A collection of connections. */
-    typedef std::vector<ConnectionDetails> ConnectionList;
+    /*! @brief A mapping from keys to entities. */
+    typedef std::map<string, ServiceEntity *> EntityMap;
     
-    /*! @brief A collection of services and ports. */
-    typedef std::list<ServiceEntity *> EntityList;
+    /*! @brief A mapping from entities to layout node indices. */
+    typedef std::map<ServiceEntity *, size_t> NodeIndexMap;
     
     /*! @brief A mapping from strings to ports. */
     typedef std::map<string, PortEntry *> PortEntryMap;
     
-    /*! @brief A collection of port names. */
-    typedef std::map<string, NameAndDirection> PortMap;
+    /*! @brief The currently displayed set of known entities. */
+    EntityList _foregroundEntities;
     
-    /*! @brief A collection of port names. */
-    typedef std::set<string> PortSet;
+    /*! @brief The currently displayed set of known entities, by scan key. */
+    EntityMap _entityMap;
     
-    /*! @brief A mapping from strings to service descriptions. */
-    typedef std::map<string, MplusM::Utilities::ServiceDescriptor> ServiceMap;
+    /*! @brief The keys of the entities that are waiting for a layout to be applied. */
+    std::set<string> _unplacedKeys;
     
-    /*! @brief A collection of visible services and ports. */
-    EntityList _entities1;
+    /*! @brief The currently displayed set of known ports. */
+    PortEntryMap _foregroundPorts;
     
-    /*! @brief A collection of visible services and ports. */
-    EntityList _entities2;
+    /*! @brief The results of the scan in progress and of the most recent scans. */
+    ScanSnapshotBuffer _scanBuffer;
     
-    /*! @brief A set of known ports. */
-    PortEntryMap _ports1;
+    /*! @brief The timing of the scans and their requests. */
+    ScanStatistics _statistics;
     
-    /*! @brief A set of known ports. */
-    PortEntryMap _ports2;
+    /*! @brief The results of the previous scan, used by the scanner to detect changes. */
+    ScanSnapshot _previousScan;
     
-    /*! @brief A set of known services. */
-    ServiceMap _detectedServices;
+    /*! @brief The results of the scan that is currently displayed. */
+    ScanSnapshot _foregroundData;
     
-    /*! @brief A set of known ports. */
-    PortSet _rememberedPorts;
+    /*! @brief The batched drawing of the connections between the displayed entities. */
+    ConnectionRenderer _connectionRenderer;
     
-    /*! @brief A set of associated ports. */
-    AssociatesMap _associatedPorts;
+    /*! @brief The spatial index used to find the entity under the mouse. */
+    EntityGrid _entityGrid;
     
-    /*! @brief A set of standalone ports. */
-    PortMap _standalonePorts;
+    /*! @brief The known port directions. */
+    PortDirectionCache _directionCache;
     
-    /*! @brief A set of connections. */
-    ConnectionList _connections;
-    
-    /*! @brief Control access to the currently-displayed lists. */
-    ofMutex _foregroundLock;
-    
-    /*! @brief The background set of known entities. */
-    EntityList * _backgroundEntities;
-    
-    /*! @brief The foreground set of known entities. */
-    EntityList * _foregroundEntities;
-    
-    /*! @brief The background set of known ports. */
-    PortEntryMap * _backgroundPorts;
-    
-    /*! @brief The foreground set of known ports. */
-    PortEntryMap * _foregroundPorts;
+    /*! @brief The known service descriptors. */
+    ServiceDescriptorCache _descriptorCache;
     
     /*! @brief The starting port for a connection being added. */
     PortEntry * _firstAddPort;
@@ -485,12 +591,41 @@ private :
     /*! @brief The background port scanner. */
     BackgroundScanner * _scanner;
     
+    /*! @brief The background layout calculator. */
+    LayoutWorker * _layoutWorker;
+    
+    /*! @brief The threads used to issue the requests of a scan concurrently. */
+    ScanWorkerPool * _scanWorkers;
+    
+    /*! @brief The entity that received the last mouse-pressed event, which receives the mouse
+     events until the mouse is released. */
+    ServiceEntity * _mouseTarget;
+    
+    /*! @brief The stream of changes found by the scans, or @c NULL if the changes are not being
+     published. */
+    ChangeFeed * _changeFeed;
+    
+    /*! @brief The network being scanned. */
+    ScanSource * _scanSource;
+    
+    /*! @brief The time when the scan statistics were last saved. */
+    float _lastStatisticsSaveTime;
+    
     /*! @brief The horizontal coordinate of the current drag location. */
     float _dragXpos;
     
     /*! @brief The vertical coordinate of the current drag location. */
     float _dragYpos;
     
+    /*! @brief The position in the display that is held under the mouse while panning. */
+    ofPoint _panAnchor;
+    
+    /*! @brief The position in the display that is shown at the top left corner of the window. */
+    ofPoint _viewOrigin;
+    
+    /*! @brief The scale of the display, which is changed by zooming. */
+    float _viewScale;
+    
 # if defined(CHECK_FOR_STALE_PORTS)
     /*! @brief The time when the last stale removal occurred. */
     float _lastStaleTime;
@@ -515,15 +650,15 @@ private :
      otherwise. */
     bool _dragActive;
     
-    /*! @brief @c true if the next scan will be ignored and @c false otherwise. */
-    bool _ignoreNextScan;
-    
     /*! @brief @c true if an entity is being moved. */
     bool _movementActive;
     
     /*! @brief @c true if the YARP network is running. */
     bool _networkAvailable;
     
+    /*! @brief @c true if the display is being panned by dragging and @c false otherwise. */
+    bool _panActive;
+    
     /*! @brief @c true if the service registry can be used. */
     bool _registryAvailable;
     
@@ -533,6 +668,9 @@ private :
     /*! @brief @c true if the SHIFT modifier key is depressed and @c false otherwise. */
     bool _shiftActive;
     
+    /*! @brief @c true if the scan statistics are to be displayed and @c false otherwise. */
+    bool _statisticsVisible;
+    
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
 #  pragma clang diagnostic ignored "-Wunused-private-field"
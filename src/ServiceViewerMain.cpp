@@ -36,13 +36,23 @@
 //
 //--------------------------------------------------------------------------------------------------
 
+#include "BenchmarkRunner.h"
+#include "RecordingScanSource.h"
+#include "ReplayScanSource.h"
 #include "ServiceViewerApp.h"
+#include "SyntheticScanSource.h"
+#include "YarpScanSource.h"
 
 //#include <odlEnable.h>
 #include <odlInclude.h>
 
 #include "ofAppRunner.h"
 
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
 #if defined(__APPLE__)
 # pragma clang diagnostic push
 # pragma clang diagnostic ignored "-Wunknown-pragmas"
@@ -78,10 +88,81 @@
 # pragma mark Private structures, constants and variables
 #endif // defined(__APPLE__)
 
+/*! @brief The number of times that each stage is run for each benchmark case. */
+static const int kBenchmarkIterations = 20;
+
+/*! @brief The default time between scans when running without a display, in seconds. */
+static const float kDefaultHeadlessInterval = 5;
+
+/*! @brief Set when a request to stop has been received while running without a display. */
+static volatile sig_atomic_t lStopRequested = 0;
+
 #if defined(__APPLE__)
 # pragma mark Local functions
 #endif // defined(__APPLE__)
 
+/*! @brief Check if a request to stop has been received.
+ @param stuff Unused.
+ @returns @c true if a request to stop has been received and @c false otherwise. */
+static bool
+checkForStop(void * stuff)
+{
+#if MAC_OR_LINUX_
+# pragma unused(stuff)
+#endif // MAC_OR_LINUX_
+    return (0 != lStopRequested);
+} // checkForStop
+
+/*! @brief Give the application a generated or recorded network to scan, and record the scans,
+ if requested.
+ @param theApp The application object.
+ @param useSynthetic @c true if a generated network is to be scanned and @c false otherwise.
+ @param parameters The shape of the generated network.
+ @param replayPath The recording to be scanned instead of the network, or empty if none.
+ @param recordPath The file to be replaced with a recording of the scans, or empty if none. */
+static void
+setUpScanSource(ServiceViewerApp &                      theApp,
+                const bool                              useSynthetic,
+                const SyntheticScanSource::Parameters & parameters,
+                const string &                          replayPath,
+                const string &                          recordPath)
+{
+    ODL_ENTER(); //####
+    ODL_P2("theApp = ", &theApp, "parameters = ", &parameters); //####
+    ODL_B1("useSynthetic = ", useSynthetic); //####
+    ODL_S2s("replayPath = ", replayPath, "recordPath = ", recordPath); //####
+    ScanSource * source = NULL;
+    
+    if (! replayPath.empty())
+    {
+        source = new ReplayScanSource(replayPath);
+    }
+    else if (useSynthetic)
+    {
+        source = new SyntheticScanSource(parameters);
+    }
+    if (! recordPath.empty())
+    {
+        source = new RecordingScanSource(source ? source : new YarpScanSource, recordPath);
+    }
+    if (source)
+    {
+        theApp.setScanSource(source);
+    }
+    ODL_EXIT(); //####
+} // setUpScanSource
+
+/*! @brief Record a request to stop.
+ @param signal The signal that was received. */
+static void
+catchStopSignal(int signal)
+{
+#if MAC_OR_LINUX_
+# pragma unused(signal)
+#endif // MAC_OR_LINUX_
+    lStopRequested = 1;
+} // catchStopSignal
+
 #if defined(__APPLE__)
 # pragma mark Class methods
 #endif // defined(__APPLE__)
@@ -110,6 +191,23 @@
  
  There is no input and the output consists of a list of ports and what, if anything, is connected to
  them.
+ 
+ With '--headless', no window is opened and each scan is written as a single-line JSON object,
+ either to the standard output or, with '--output', by replacing the given file. The time between
+ scans can be set with '--interval', in seconds, and '--once' writes a single scan and exits.
+ 
+ In either mode, '--feed' writes the changes found by each scan as JSON lines to a file, a named
+ pipe or, with a 'unix:' prefix, a local socket, and '--synthetic' scans a generated network
+ instead of the YARP network. Its argument is the number of services, the number of ports for each
+ service and the number of connections, separated by commas, optionally followed by the delay
+ for each request in milliseconds, the number of services that never respond and the number of
+ standalone ports. The results of each scan can be written to a file with '--record', and a file
+ written that way can be scanned instead of the network with '--replay'.
+ 
+ With '--benchmark', the stages of scanning and display are timed against generated networks of
+ about 10, 100 and 5000 entities, or against the network given with '--synthetic' or '--replay',
+ and the results are written as a JSON object, either to the standard output or to the file given
+ with '--output'.
  @param argc The number of arguments in 'argv'.
  @param argv The arguments to be used with the example client.
  @returns @c 0 on a successful test and @c 1 on failure. */
@@ -117,9 +215,6 @@ int
 main(int      argc,
      char * * argv)
 {
-#if MAC_OR_LINUX_
-# pragma unused(argc)
-#endif // MAC_OR_LINUX_
 #if defined(MpM_ServicesLogToStandardError)
     ODL_INIT(*argv, kODLoggingOptionIncludeProcessID | kODLoggingOptionIncludeThreadID | //####
                 kODLoggingOptionWriteToStderr | kODLoggingOptionEnableThreadSupport); //####
@@ -128,6 +223,79 @@ main(int      argc,
                 kODLoggingOptionEnableThreadSupport); //####
 #endif // ! defined(MpM_ServicesLogToStandardError)
     ODL_ENTER(); //####
+    bool                            benchmark = false;
+    bool                            headless = false;
+    bool                            scanOnce = false;
+    bool                            useSynthetic = false;
+    float                           scanInterval = kDefaultHeadlessInterval;
+    int                             result = 0;
+    string                          feedDestination;
+    string                          outputPath;
+    string                          recordPath;
+    string                          replayPath;
+    SyntheticScanSource::Parameters syntheticParameters;
+    
+    for (int ii = 1; (0 == result) && (argc > ii); ++ii)
+    {
+        const char * anArg = argv[ii];
+        
+        if (! strcmp(anArg, "--headless"))
+        {
+            headless = true;
+        }
+        else if (! strcmp(anArg, "--benchmark"))
+        {
+            benchmark = true;
+        }
+        else if (! strcmp(anArg, "--once"))
+        {
+            headless = scanOnce = true;
+        }
+        else if ((! strcmp(anArg, "--output")) && (argc > (ii + 1)))
+        {
+            headless = true;
+            outputPath = argv[++ii];
+        }
+        else if ((! strcmp(anArg, "--feed")) && (argc > (ii + 1)))
+        {
+            feedDestination = argv[++ii];
+        }
+        else if ((! strcmp(anArg, "--record")) && (argc > (ii + 1)))
+        {
+            recordPath = argv[++ii];
+        }
+        else if ((! strcmp(anArg, "--replay")) && (argc > (ii + 1)))
+        {
+            replayPath = argv[++ii];
+        }
+        else if ((! strcmp(anArg, "--synthetic")) && (argc > (ii + 1)))
+        {
+            const char * description = argv[++ii];
+            
+            useSynthetic = SyntheticScanSource::ParseParameters(description, syntheticParameters);
+            if (! useSynthetic)
+            {
+                ODL_LOG("(! useSynthetic)"); //####
+                std::cerr << "Invalid synthetic network '" << description << "'; expected " <<
+                            "services,ports,connections[,delay[,hung[,standalone]]]." << std::endl;
+                result = 1;
+            }
+        }
+        else if ((! strcmp(anArg, "--interval")) && (argc > (ii + 1)))
+        {
+            scanInterval = static_cast<float> (atof(argv[++ii]));
+            if (0 >= scanInterval)
+            {
+                scanInterval = kDefaultHeadlessInterval;
+            }
+        }
+    }
+    // An invalid argument stops the application, rather than scanning something unexpected.
+    if (0 != result)
+    {
+        ODL_EXIT_I(result); //####
+        return result;
+    }
 #if MAC_OR_LINUX_
     MplusM::Common::SetUpLogger(*argv);
 #endif // MAC_OR_LINUX_
@@ -136,17 +304,78 @@ main(int      argc,
     
     try
     {
-        ofSetupOpenGL(1024, 768, OF_WINDOW);
-        MplusM::Common::Initialize(*argv);
-        ofRunApp(new ServiceViewerApp);
+        if (benchmark)
+        {
+            // The stages are run directly, without running the application, but drawing needs a
+            // GL context.
+            BenchmarkRunner runner(kBenchmarkIterations);
+            
+            ofSetupOpenGL(1024, 768, OF_WINDOW);
+            MplusM::Common::Initialize(*argv);
+            if (! replayPath.empty())
+            {
+                runner.addRecordedCase("replay", replayPath);
+            }
+            else if (useSynthetic)
+            {
+                runner.addCase("synthetic", syntheticParameters);
+            }
+            else
+            {
+                runner.addStandardCases();
+            }
+            if (! runner.run(outputPath))
+            {
+                ODL_LOG("(! runner.run(outputPath))"); //####
+                result = 1;
+            }
+        }
+        else if (headless)
+        {
+            // The scanning pipeline is run directly, without a window or a GL context.
+            ServiceViewerApp * theApp;
+            
+            signal(SIGINT, catchStopSignal);
+            signal(SIGTERM, catchStopSignal);
+            MplusM::Common::Initialize(*argv);
+            theApp = new ServiceViewerApp;
+            setUpScanSource(*theApp, useSynthetic, syntheticParameters, replayPath, recordPath);
+            if (! feedDestination.empty())
+            {
+                theApp->setChangeFeed(feedDestination);
+            }
+            if (! theApp->runHeadless(outputPath, scanInterval, scanOnce, checkForStop))
+            {
+                ODL_LOG("(! theApp->runHeadless(outputPath, scanInterval, scanOnce, " //####
+                        "checkForStop))"); //####
+                result = 1;
+            }
+            theApp->exit();
+            delete theApp;
+        }
+        else
+        {
+            ServiceViewerApp * theApp;
+            
+            ofSetupOpenGL(1024, 768, OF_WINDOW);
+            MplusM::Common::Initialize(*argv);
+            theApp = new ServiceViewerApp;
+            setUpScanSource(*theApp, useSynthetic, syntheticParameters, replayPath, recordPath);
+            if (! feedDestination.empty())
+            {
+                theApp->setChangeFeed(feedDestination);
+            }
+            ofRunApp(theApp);
+        }
     }
     catch (...)
     {
         ODL_LOG("Exception caught"); //####
+        result = 1;
     }
     yarp::os::Network::fini();
-    ODL_EXIT_I(0); //####
-    return 0;
+    ODL_EXIT_I(result); //####
+    return result;
 } // main
 #if (! MAC_OR_LINUX_)
 # pragma warning(pop\textbf{q})
@@ -0,0 +1,606 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       SyntheticScanSource.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for scanning a generated network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "SyntheticScanSource.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#include "ofUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for scanning a generated network. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+/*! @brief The prefix for the names of the ports in the network. */
+#define PORT_NAME_PREFIX "/synthetic/"
+
+/*! @brief The IP address given to every port in the network. */
+#define SYNTHETIC_ADDRESS "127.0.0.1"
+
+/*! @brief The number of attempts made for each connection, as some pairings are not usable. */
+static const size_t kConnectionAttempts = 4;
+
+/*! @brief The first port number given to the ports in the network. */
+static const int kFirstPortNumber = 20000;
+
+/*! @brief The longest time to sleep before checking for early exit, in milliseconds. */
+static const int kPollInterval = 10;
+
+/*! @brief The starting value for the random number generator, so that the same network is always
+ generated. */
+static const unsigned long kRandomSeed = 12345;
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+/*! @brief Return a description of a port.
+ @param portName The name of the port.
+ @returns A description of the port. */
+static MplusM::Common::ChannelDescription
+makeChannel(const string & portName)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    MplusM::Common::ChannelDescription result;
+    
+    result._portName = portName.c_str();
+    result._portProtocol = "";
+    result._portMode = MplusM::Common::kChannelModeTCP;
+    ODL_EXIT(); //####
+    return result;
+} // makeChannel
+
+/*! @brief Return the next value from a simple pseudo-random number generator.
+ 
+ The standard generator is not used, as its sequence differs between platforms.
+ @param seed The state of the generator.
+ @returns The next value from the generator. */
+static size_t
+nextRandom(unsigned long & seed)
+{
+    ODL_ENTER(); //####
+    ODL_P1("seed = ", &seed); //####
+    size_t result;
+    
+    seed = ((seed * 1103515245) + 12345) & 0x7FFFFFFF;
+    result = static_cast<size_t> (seed >> 8);
+    ODL_EXIT_L(result); //####
+    return result;
+} // nextRandom
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+bool
+SyntheticScanSource::ParseParameters(const string & text,
+                                     Parameters &   parameters)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("text = ", text); //####
+    ODL_P1("parameters = ", &parameters); //####
+    std::vector<string> fields(ofSplitString(text, ",", true, true));
+    bool                result = (3 <= fields.size()) && (6 >= fields.size());
+    
+    parameters._serviceCount = parameters._portsPerService = parameters._connectionCount = 0;
+    parameters._hungServiceCount = parameters._standaloneCount = 0;
+    parameters._latency = 0;
+    for (size_t ii = 0; result && (fields.size() > ii); ++ii)
+    {
+        int aValue = ofToInt(fields[ii]);
+        
+        if (0 > aValue)
+        {
+            result = false;
+        }
+        else
+        {
+            switch (ii)
+            {
+                case 0 :
+                    parameters._serviceCount = static_cast<size_t> (aValue);
+                    break;
+                
+                case 1 :
+                    parameters._portsPerService = static_cast<size_t> (aValue);
+                    break;
+                
+                case 2 :
+                    parameters._connectionCount = static_cast<size_t> (aValue);
+                    break;
+                
+                case 3 :
+                    parameters._latency = aValue;
+                    break;
+                
+                case 4 :
+                    parameters._hungServiceCount = static_cast<size_t> (aValue);
+                    break;
+                
+                default :
+                    parameters._standaloneCount = static_cast<size_t> (aValue);
+                    break;
+                
+            }
+        }
+    }
+    ODL_EXIT_B(result); //####
+    return result;
+} // SyntheticScanSource::ParseParameters
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+SyntheticScanSource::SyntheticScanSource(const Parameters & parameters) :
+    inherited(), _parameters(parameters), _ports(), _serviceNames(), _services(), _directions(),
+    _hungPorts(), _connections(), _lock()
+{
+    ODL_ENTER(); //####
+    ODL_P1("parameters = ", &parameters); //####
+    ODL_EXIT_P(this); //####
+} // SyntheticScanSource::SyntheticScanSource
+
+SyntheticScanSource::~SyntheticScanSource(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::~SyntheticScanSource
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+SyntheticScanSource::addConnection(const yarp::os::ConstString & sourceName,
+                                   const yarp::os::ConstString & destinationName,
+                                   const bool                    isUDP)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    ODL_B1("isUDP = ", isUDP); //####
+    bool result = false;
+    
+    if ((_directions.end() != _directions.find(sourceName.c_str())) &&
+        (_directions.end() != _directions.find(destinationName.c_str())))
+    {
+        MplusM::Common::ChannelDescription aChannel(makeChannel(destinationName.c_str()));
+        
+        if (isUDP)
+        {
+            aChannel._portMode = MplusM::Common::kChannelModeUDP;
+        }
+        _lock.lock();
+        _connections[sourceName.c_str()].push_back(aChannel);
+        _lock.unlock();
+        result = true;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // SyntheticScanSource::addConnection
+
+void
+SyntheticScanSource::addPort(const string &                 portName,
+                             const PortEntry::PortDirection direction)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_L1("direction = ", direction); //####
+    MplusM::Utilities::PortDescriptor aPort;
+    char                              numBuff[30];
+    
+#if MAC_OR_LINUX_
+    snprintf(numBuff, sizeof(numBuff), "%d", kFirstPortNumber + static_cast<int> (_ports.size()));
+#else // ! MAC_OR_LINUX_
+    _snprintf(numBuff, sizeof(numBuff) - 1, "%d",
+              kFirstPortNumber + static_cast<int> (_ports.size()));
+    // Correct for the weird behaviour of _snprintf
+    numBuff[sizeof(numBuff) - 1] = '\0';
+#endif // ! MAC_OR_LINUX_
+    aPort._portName = portName.c_str();
+    aPort._portIpAddress = SYNTHETIC_ADDRESS;
+    aPort._portPortNumber = numBuff;
+    _ports.push_back(aPort);
+    _directions[portName] = direction;
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::addPort
+
+void
+SyntheticScanSource::buildNetwork(void)
+{
+    ODL_OBJENTER(); //####
+    std::vector<string> sources;
+    std::vector<string> destinations;
+    std::set<string>    madeConnections;
+    unsigned long       seed = kRandomSeed;
+    size_t              inputCount = ((_parameters._portsPerService + 1) / 2);
+    
+    _ports.clear();
+    _serviceNames.clear();
+    _services.clear();
+    _directions.clear();
+    _hungPorts.clear();
+    _lock.lock();
+    _connections.clear();
+    _lock.unlock();
+    for (size_t ii = 0; _parameters._serviceCount > ii; ++ii)
+    {
+        MplusM::Utilities::ServiceDescriptor descriptor;
+        string                               serviceName(PORT_NAME_PREFIX "service/" +
+                                                         ofToString(ii));
+        bool                                 isHung = (_parameters._hungServiceCount > ii);
+        
+        descriptor._serviceName = ("Synthetic " + ofToString(ii)).c_str();
+        descriptor._channelName = serviceName.c_str();
+        descriptor._kind = "Normal";
+        descriptor._description = "A generated service";
+        descriptor._requestsDescription = "";
+        descriptor._path = "";
+        addPort(serviceName, PortEntry::kPortDirectionInput);
+        for (size_t jj = 0; _parameters._portsPerService > jj; ++jj)
+        {
+            string portName(serviceName + "/" + ofToString(jj));
+            
+            if (inputCount > jj)
+            {
+                addPort(portName, PortEntry::kPortDirectionInput);
+                descriptor._inputChannels.push_back(makeChannel(portName));
+                destinations.push_back(portName);
+            }
+            else
+            {
+                addPort(portName, PortEntry::kPortDirectionOutput);
+                descriptor._outputChannels.push_back(makeChannel(portName));
+                sources.push_back(portName);
+            }
+            if (isHung)
+            {
+                _hungPorts.insert(portName);
+            }
+        }
+        if (isHung)
+        {
+            _hungPorts.insert(serviceName);
+        }
+        _serviceNames.push_back(serviceName.c_str());
+        _services[serviceName] = descriptor;
+    }
+    for (size_t ii = 0; _parameters._standaloneCount > ii; ++ii)
+    {
+        string portName(PORT_NAME_PREFIX "port/" + ofToString(ii));
+        
+        // Mix the directions, so that all the kinds of standalone port are present.
+        switch (ii % 3)
+        {
+            case 0 :
+                addPort(portName, PortEntry::kPortDirectionInput);
+                destinations.push_back(portName);
+                break;
+            
+            case 1 :
+                addPort(portName, PortEntry::kPortDirectionOutput);
+                sources.push_back(portName);
+                break;
+            
+            default :
+                addPort(portName, PortEntry::kPortDirectionInputOutput);
+                sources.push_back(portName);
+                destinations.push_back(portName);
+                break;
+            
+        }
+    }
+    if ((! sources.empty()) && (! destinations.empty()))
+    {
+        size_t attempts = (_parameters._connectionCount * kConnectionAttempts);
+        
+        _lock.lock();
+        for (size_t ii = 0; (_parameters._connectionCount > madeConnections.size()) &&
+             (attempts > ii); ++ii)
+        {
+            const string & sourceName = sources[nextRandom(seed) % sources.size()];
+            const string & destinationName = destinations[nextRandom(seed) %
+                                                          destinations.size()];
+            
+            if ((sourceName != destinationName) &&
+                madeConnections.insert(sourceName + " " + destinationName).second)
+            {
+                _connections[sourceName].push_back(makeChannel(destinationName));
+            }
+        }
+        _lock.unlock();
+    }
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::buildNetwork
+
+bool
+SyntheticScanSource::checkForRegistryService(const MplusM::Utilities::PortVector & detectedPorts)
+{
+#if MAC_OR_LINUX_
+# pragma unused(detectedPorts)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    // There are no associated ports in a generated network.
+    ODL_OBJEXIT_B(false); //####
+    return false;
+} // SyntheticScanSource::checkForRegistryService
+
+void
+SyntheticScanSource::gatherPortConnections(const yarp::os::ConstString &   portName,
+                                           MplusM::Common::ChannelVector & outputs,
+                                           MplusM::Common::CheckFunction   checker,
+                                           void *                          checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("outputs = ", &outputs, "checkStuff = ", checkStuff); //####
+    outputs.clear();
+    if (_hungPorts.end() == _hungPorts.find(portName.c_str()))
+    {
+        simulateLatency(checker, checkStuff);
+        _lock.lock();
+        ConnectionMap::const_iterator match(_connections.find(portName.c_str()));
+        
+        if (_connections.end() != match)
+        {
+            outputs = match->second;
+        }
+        _lock.unlock();
+    }
+    else
+    {
+        waitUntilExpired(checker, checkStuff);
+    }
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::gatherPortConnections
+
+bool
+SyntheticScanSource::getAssociatedPorts(const yarp::os::ConstString &        portName,
+                                        MplusM::Utilities::PortAssociation & associates,
+                                        MplusM::Common::CheckFunction        checker,
+                                        void *                               checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("associates = ", &associates, "checkStuff = ", checkStuff); //####
+    simulateLatency(checker, checkStuff);
+    associates._inputs.clear();
+    associates._outputs.clear();
+    associates._primary = associates._valid = false;
+    ODL_OBJEXIT_B(false); //####
+    return false;
+} // SyntheticScanSource::getAssociatedPorts
+
+void
+SyntheticScanSource::getDetectedPortList(MplusM::Utilities::PortVector & detectedPorts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    simulateLatency(NULL, NULL);
+    detectedPorts = _ports;
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::getDetectedPortList
+
+bool
+SyntheticScanSource::getNameAndDescriptionForService(const yarp::os::ConstString &          serviceName,
+                                                     MplusM::Utilities::ServiceDescriptor & descriptor,
+                                                     MplusM::Common::CheckFunction          checker,
+                                                     void *                                 checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("serviceName = ", serviceName); //####
+    ODL_P2("descriptor = ", &descriptor, "checkStuff = ", checkStuff); //####
+    bool result = false;
+    
+    if (_hungPorts.end() == _hungPorts.find(serviceName.c_str()))
+    {
+        ServiceMap::const_iterator match(_services.find(serviceName.c_str()));
+        
+        simulateLatency(checker, checkStuff);
+        if (_services.end() != match)
+        {
+            descriptor = match->second;
+            result = true;
+        }
+    }
+    else
+    {
+        waitUntilExpired(checker, checkStuff);
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // SyntheticScanSource::getNameAndDescriptionForService
+
+bool
+SyntheticScanSource::getServiceNames(MplusM::Common::StringVector & services,
+                                     MplusM::Common::CheckFunction  checker,
+                                     void *                         checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("services = ", &services, "checkStuff = ", checkStuff); //####
+    simulateLatency(checker, checkStuff);
+    services = _serviceNames;
+    ODL_OBJEXIT_B(true); //####
+    return true;
+} // SyntheticScanSource::getServiceNames
+
+bool
+SyntheticScanSource::lookupDirection(const yarp::os::ConstString & portName,
+                                     PortEntry::PortDirection &    direction)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P1("direction = ", &direction); //####
+    DirectionMap::const_iterator match(_directions.find(portName.c_str()));
+    bool                         result = (_directions.end() != match);
+    
+    if (result)
+    {
+        direction = match->second;
+    }
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // SyntheticScanSource::lookupDirection
+
+bool
+SyntheticScanSource::removeConnection(const yarp::os::ConstString & sourceName,
+                                      const yarp::os::ConstString & destinationName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    bool result = false;
+    
+    _lock.lock();
+    ConnectionMap::iterator match(_connections.find(sourceName.c_str()));
+    
+    if (_connections.end() != match)
+    {
+        MplusM::Common::ChannelVector & outputs = match->second;
+        
+        for (MplusM::Common::ChannelVector::iterator walker(outputs.begin());
+             outputs.end() != walker; ++walker)
+        {
+            if (walker->_portName == destinationName)
+            {
+                outputs.erase(walker);
+                result = true;
+                break;
+            }
+            
+        }
+    }
+    _lock.unlock();
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // SyntheticScanSource::removeConnection
+
+void
+SyntheticScanSource::removeStalePorts(void)
+{
+    ODL_OBJENTER(); //####
+    // A generated network never has stale ports.
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::removeStalePorts
+
+bool
+SyntheticScanSource::requiresDirectionProbing(void)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT_B(false); //####
+    return false;
+} // SyntheticScanSource::requiresDirectionProbing
+
+void
+SyntheticScanSource::simulateLatency(MplusM::Common::CheckFunction checker,
+                                     void *                        checkStuff)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("checkStuff = ", checkStuff); //####
+    for (int remaining = _parameters._latency; 0 < remaining; remaining -= kPollInterval)
+    {
+        if (checker && checker(checkStuff))
+        {
+            break;
+        }
+        
+        ofSleepMillis(std::min(remaining, kPollInterval));
+    }
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::simulateLatency
+
+bool
+SyntheticScanSource::start(void)
+{
+    ODL_OBJENTER(); //####
+    buildNetwork();
+    ODL_OBJEXIT_B(true); //####
+    return true;
+} // SyntheticScanSource::start
+
+void
+SyntheticScanSource::stop(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::stop
+
+void
+SyntheticScanSource::waitUntilExpired(MplusM::Common::CheckFunction checker,
+                                      void *                        checkStuff)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("checkStuff = ", checkStuff); //####
+    float giveUpTime = ofGetElapsedTimef() + STANDARD_WAIT_TIME;
+    
+    // Without an early exit function, a real request would give up after its timeout.
+    while (giveUpTime > ofGetElapsedTimef())
+    {
+        if (checker && checker(checkStuff))
+        {
+            break;
+        }
+        
+        ofSleepMillis(kPollInterval);
+    }
+    ODL_OBJEXIT(); //####
+} // SyntheticScanSource::waitUntilExpired
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)
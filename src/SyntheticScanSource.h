@@ -0,0 +1,306 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       SyntheticScanSource.h
+//
+//  Project:    M+M
+//
+//  Contains:   The class declaration for scanning a generated network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#if (! defined(__ServiceViewer__SyntheticScanSource__))
+# define __ServiceViewer__SyntheticScanSource__  /* Header guard */
+
+# include "ScanSource.h"
+
+# include "ofTypes.h"
+
+# include <map>
+# include <set>
+
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunknown-pragmas"
+#  pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class declaration for scanning a generated network. */
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+
+/*! @brief Scanning a generated network.
+ 
+ The network is built from a small set of parameters, so that scans of networks of known sizes
+ can be repeated without a YARP name server or any services. Each request can be given a fixed
+ delay, and some of the services can be made to never respond, so that the handling of slow and
+ hung services can be measured. The same parameters always produce the same network. */
+class SyntheticScanSource : public ScanSource
+{
+public :
+    
+    /*! @brief The shape of the generated network. */
+    struct Parameters
+    {
+        /*! @brief The number of services. */
+        size_t _serviceCount;
+        
+        /*! @brief The number of ports belonging to each service, in addition to its service
+         port. */
+        size_t _portsPerService;
+        
+        /*! @brief The number of connections between ports. */
+        size_t _connectionCount;
+        
+        /*! @brief The number of services that never respond. */
+        size_t _hungServiceCount;
+        
+        /*! @brief The number of ports that do not belong to a service. */
+        size_t _standaloneCount;
+        
+        /*! @brief The delay added to each request, in milliseconds. */
+        int _latency;
+        
+# if defined(__APPLE__)
+#  pragma clang diagnostic push
+#  pragma clang diagnostic ignored "-Wunused-private-field"
+# endif // defined(__APPLE__)
+        /*! @brief Filler to pad to alignment boundary */
+        char _filler[4];
+# if defined(__APPLE__)
+#  pragma clang diagnostic pop
+# endif // defined(__APPLE__)
+        
+    }; // Parameters
+    
+    /*! @brief The constructor.
+     @param parameters The shape of the generated network. */
+    explicit
+    SyntheticScanSource(const Parameters & parameters);
+    
+    /*! @brief The destructor. */
+    virtual
+    ~SyntheticScanSource(void);
+    
+    /*! @brief Connect two ports.
+     @param sourceName The name of the source port.
+     @param destinationName The name of the destination port.
+     @param isUDP @c true if the connection is to use UDP and @c false otherwise.
+     @returns @c true if the connection was made and @c false otherwise. */
+    virtual bool
+    addConnection(const yarp::os::ConstString & sourceName,
+                  const yarp::os::ConstString & destinationName,
+                  const bool                    isUDP);
+    
+    /*! @brief Check if the Registry Service is present.
+     @param detectedPorts The set of detected ports.
+     @returns @c true if the Registry Service is present and @c false otherwise. */
+    virtual bool
+    checkForRegistryService(const MplusM::Utilities::PortVector & detectedPorts);
+    
+    /*! @brief Retrieve the ports that a port is sending to.
+     @param portName The name of the port.
+     @param outputs The ports that the port is sending to.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    virtual void
+    gatherPortConnections(const yarp::os::ConstString &   portName,
+                          MplusM::Common::ChannelVector & outputs,
+                          MplusM::Common::CheckFunction   checker,
+                          void *                          checkStuff);
+    
+    /*! @brief Retrieve the associates of a port.
+     @param portName The name of the port.
+     @param associates The associates of the port.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the associates were retrieved and @c false otherwise. */
+    virtual bool
+    getAssociatedPorts(const yarp::os::ConstString &        portName,
+                       MplusM::Utilities::PortAssociation & associates,
+                       MplusM::Common::CheckFunction        checker,
+                       void *                               checkStuff);
+    
+    /*! @brief Retrieve the ports that are present.
+     @param detectedPorts The set of detected ports. */
+    virtual void
+    getDetectedPortList(MplusM::Utilities::PortVector & detectedPorts);
+    
+    /*! @brief Retrieve the descriptor of a service.
+     @param serviceName The name of the service port.
+     @param descriptor The descriptor of the service.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the descriptor was retrieved and @c false otherwise. */
+    virtual bool
+    getNameAndDescriptionForService(const yarp::os::ConstString &          serviceName,
+                                    MplusM::Utilities::ServiceDescriptor & descriptor,
+                                    MplusM::Common::CheckFunction          checker,
+                                    void *                                 checkStuff);
+    
+    /*! @brief Retrieve the names of the service ports that are present.
+     @param services The names of the service ports.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function.
+     @returns @c true if the names were retrieved and @c false otherwise. */
+    virtual bool
+    getServiceNames(MplusM::Common::StringVector & services,
+                    MplusM::Common::CheckFunction  checker,
+                    void *                         checkStuff);
+    
+    /*! @brief Find the direction of a port without testing it.
+     @param portName The name of the port.
+     @param direction The direction of the port, if it is known.
+     @returns @c true if the direction of the port is known and @c false if it must be determined
+     by testing the port. */
+    virtual bool
+    lookupDirection(const yarp::os::ConstString & portName,
+                    PortEntry::PortDirection &    direction);
+    
+    /*! @brief Disconnect two ports.
+     @param sourceName The name of the source port.
+     @param destinationName The name of the destination port.
+     @returns @c true if the connection was removed and @c false otherwise. */
+    virtual bool
+    removeConnection(const yarp::os::ConstString & sourceName,
+                     const yarp::os::ConstString & destinationName);
+    
+    /*! @brief Remove the ports that are no longer responding. */
+    virtual void
+    removeStalePorts(void);
+    
+    /*! @brief Returns @c true if the directions of ports must be determined by testing them.
+     @returns @c true if the directions of ports must be determined by testing them and @c false
+     if they are all known ahead of time. */
+    virtual bool
+    requiresDirectionProbing(void)
+    const;
+    
+    /*! @brief Prepare the network to be scanned.
+     @returns @c true if the network can be scanned and @c false otherwise. */
+    virtual bool
+    start(void);
+    
+    /*! @brief Release the resources used to scan the network. */
+    virtual void
+    stop(void);
+    
+    /*! @brief Convert a description of a network into a set of parameters.
+     
+     The description is a comma-separated list of the number of services, the number of ports for
+     each service and the number of connections, optionally followed by the delay for each
+     request in milliseconds, the number of hung services and the number of standalone ports.
+     @param text The description of the network.
+     @param parameters The shape of the network.
+     @returns @c true if the description was valid and @c false otherwise. */
+    static bool
+    ParseParameters(const string & text,
+                    Parameters &   parameters);
+    
+protected :
+
+private :
+    
+    /*! @brief Add a port to the network.
+     @param portName The name of the port.
+     @param direction The direction of the port. */
+    void
+    addPort(const string &                 portName,
+            const PortEntry::PortDirection direction);
+    
+    /*! @brief Build the network from the parameters. */
+    void
+    buildNetwork(void);
+    
+    /*! @brief Delay a request, to simulate the network.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    void
+    simulateLatency(MplusM::Common::CheckFunction checker,
+                    void *                        checkStuff)
+    const;
+    
+    /*! @brief Wait until a request has expired, to simulate a service that does not respond.
+     @param checker A function that provides for early exit from loops.
+     @param checkStuff The private data for the early exit function. */
+    void
+    waitUntilExpired(MplusM::Common::CheckFunction checker,
+                     void *                        checkStuff)
+    const;
+    
+    COPY_AND_ASSIGNMENT_(SyntheticScanSource);
+    
+public :
+
+protected :
+
+private :
+    
+    /*! @brief The class that this class is derived from. */
+    typedef ScanSource inherited;
+    
+    /*! @brief A mapping from port names to the ports that they are sending to. */
+    typedef std::map<string, MplusM::Common::ChannelVector> ConnectionMap;
+    
+    /*! @brief A mapping from port names to port directions. */
+    typedef std::map<string, PortEntry::PortDirection> DirectionMap;
+    
+    /*! @brief A mapping from service port names to service descriptors. */
+    typedef std::map<string, MplusM::Utilities::ServiceDescriptor> ServiceMap;
+    
+    /*! @brief The shape of the network. */
+    Parameters _parameters;
+    
+    /*! @brief The ports in the network. */
+    MplusM::Utilities::PortVector _ports;
+    
+    /*! @brief The names of the service ports, in the order that they were created. */
+    MplusM::Common::StringVector _serviceNames;
+    
+    /*! @brief The services in the network. */
+    ServiceMap _services;
+    
+    /*! @brief The directions of the ports in the network. */
+    DirectionMap _directions;
+    
+    /*! @brief The ports that belong to services that never respond. */
+    std::set<string> _hungPorts;
+    
+    /*! @brief The connections in the network. */
+    ConnectionMap _connections;
+    
+    /*! @brief Control access to the connections, which can be changed while being scanned. */
+    ofMutex _lock;
+    
+}; // SyntheticScanSource
+
+#endif // ! defined(__ServiceViewer__SyntheticScanSource__)
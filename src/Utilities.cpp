@@ -83,6 +83,37 @@ static const float kControlLengthScale = 0.25;
 # pragma mark Global functions
 #endif // defined(__APPLE__)
 
+/*! @brief Calculate a bezier curve between two points.
+ @param curve The calculated curve.
+ @param startPoint The beginning of the curve.
+ @param endPoint The end of the curve.
+ @param startCentre A reference point for the beginning of the curve, used to calculate the
+ beginning tangent.
+ @param endCentre A reference point for the end of the curve, used to calculate the ending
+ tangent. */
+void
+CalculateBezier(ofPolyline &    curve,
+                const ofPoint & startPoint,
+                const ofPoint & endPoint,
+                const ofPoint & startCentre,
+                const ofPoint & endCentre)
+{
+    ODL_ENTER(); //####
+    ODL_P4("startPoint = ", &startPoint, "endPoint = ", &endPoint, "startCentre = ", //####
+              &startCentre, "endCentre = ", &endCentre); //####
+    ODL_P1("curve = ", &curve); //####
+    float   controlLength = (startPoint.distance(endPoint) * kControlLengthScale);
+    float   startAngle = atan2(startPoint.y - startCentre.y, startPoint.x - startCentre.x);
+    float   endAngle = atan2(endPoint.y - endCentre.y, endPoint.x - endCentre.x);
+    ofPoint controlPoint1(controlLength * cos(startAngle), controlLength * sin(startAngle));
+    ofPoint controlPoint2(controlLength * cos(endAngle), controlLength * sin(endAngle));
+    
+    curve.clear();
+    curve.addVertex(startPoint);
+    curve.bezierTo(startPoint + controlPoint1, endPoint + controlPoint2, endPoint);
+    ODL_EXIT();//####
+} // CalculateBezier
+
 /*! @brief Draw a bezier curve between two points.
  @param startPoint The beginning of the curve.
  @param endPoint The end of the curve.
@@ -100,14 +131,147 @@ DrawBezier(const ofPoint & startPoint,
     ODL_P4("startPoint = ", &startPoint, "endPoint = ", &endPoint, "startCentre = ", //####
               &startCentre, "endCentre = ", &endCentre); //####
     ofPolyline bLine;
-    float      controlLength = (startPoint.distance(endPoint) * kControlLengthScale);
-    float      startAngle = atan2(startPoint.y - startCentre.y, startPoint.x - startCentre.x);
-    float      endAngle = atan2(endPoint.y - endCentre.y, endPoint.x - endCentre.x);
-    ofPoint    controlPoint1(controlLength * cos(startAngle), controlLength * sin(startAngle));
-    ofPoint    controlPoint2(controlLength * cos(endAngle), controlLength * sin(endAngle));
     
-    bLine.addVertex(startPoint);
-    bLine.bezierTo(startPoint + controlPoint1, endPoint + controlPoint2, endPoint);
+    CalculateBezier(bLine, startPoint, endPoint, startCentre, endCentre);
     bLine.draw();
     ODL_EXIT();//####
 } // DrawBezier
+
+/*! @brief Return a string with the characters that are special to JSON escaped.
+ @param text The string to be escaped.
+ @returns The string with the special characters escaped. */
+string
+EscapeForJson(const string & text)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("text = ", text); //####
+    string result;
+    
+    result.reserve(text.length());
+    for (string::const_iterator walker(text.begin()); text.end() != walker; ++walker)
+    {
+        unsigned char aChar = static_cast<unsigned char> (*walker);
+        
+        switch (aChar)
+        {
+            case '"' :
+                result += "\\\"";
+                break;
+            
+            case '\\' :
+                result += "\\\\";
+                break;
+            
+            case '\n' :
+                result += "\\n";
+                break;
+            
+            case '\r' :
+                result += "\\r";
+                break;
+            
+            case '\t' :
+                result += "\\t";
+                break;
+            
+            default :
+                if (0x20 > aChar)
+                {
+                    // Other control characters are written as unicode escapes.
+                    static const char kHexDigits[] = "0123456789abcdef";
+                    
+                    result += "\\u00";
+                    result += kHexDigits[(aChar >> 4) & 0x0F];
+                    result += kHexDigits[aChar & 0x0F];
+                }
+                else
+                {
+                    result += *walker;
+                }
+                break;
+            
+        }
+    }
+    ODL_EXIT_s(result); //####
+    return result;
+} // EscapeForJson
+
+string
+EscapeForRecording(const string & text)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("text = ", text); //####
+    string result;
+    
+    result.reserve(text.length());
+    for (string::const_iterator walker(text.begin()); text.end() != walker; ++walker)
+    {
+        switch (*walker)
+        {
+            case '\\' :
+                result += "\\\\";
+                break;
+            
+            case '\n' :
+                result += "\\n";
+                break;
+            
+            case '\r' :
+                result += "\\r";
+                break;
+            
+            case '\t' :
+                result += "\\t";
+                break;
+            
+            default :
+                result += *walker;
+                break;
+            
+        }
+    }
+    ODL_EXIT_s(result); //####
+    return result;
+} // EscapeForRecording
+
+string
+UnescapeFromRecording(const string & text)
+{
+    ODL_ENTER(); //####
+    ODL_S1s("text = ", text); //####
+    string result;
+    
+    result.reserve(text.length());
+    for (string::const_iterator walker(text.begin()); text.end() != walker; ++walker)
+    {
+        if (('\\' == *walker) && (text.end() != (walker + 1)))
+        {
+            ++walker;
+            switch (*walker)
+            {
+                case 'n' :
+                    result += '\n';
+                    break;
+                
+                case 'r' :
+                    result += '\r';
+                    break;
+                
+                case 't' :
+                    result += '\t';
+                    break;
+                
+                default :
+                    result += *walker;
+                    break;
+                
+            }
+        }
+        else
+        {
+            result += *walker;
+        }
+    }
+    ODL_EXIT_s(result); //####
+    return result;
+} // UnescapeFromRecording
@@ -41,6 +41,7 @@
 
 # include "ofMesh.h"
 # include "ofPoint.h"
+# include "ofPolyline.h"
 
 # if defined(__APPLE__)
 #  pragma clang diagnostic push
@@ -54,6 +55,21 @@
 #  pragma clang diagnostic pop
 # endif // defined(__APPLE__)
 
+/*! @brief Calculate a bezier curve between two points.
+ @param curve The calculated curve.
+ @param startPoint The beginning of the curve.
+ @param endPoint The end of the curve.
+ @param startCentre A reference point for the beginning of the curve, used to calculate the
+ beginning tangent.
+ @param endCentre A reference point for the end of the curve, used to calculate the ending
+ tangent. */
+void
+CalculateBezier(ofPolyline &    curve,
+                const ofPoint & startPoint,
+                const ofPoint & endPoint,
+                const ofPoint & startCentre,
+                const ofPoint & endCentre);
+
 /*! @brief Draw a bezier curve between two points.
  @param startPoint The beginning of the curve.
  @param endPoint The end of the curve.
@@ -67,4 +83,23 @@ DrawBezier(const ofPoint & startPoint,
            const ofPoint & startCentre,
            const ofPoint & endCentre);
 
+/*! @brief Return a string with the characters that are special to JSON escaped.
+ @param text The string to be escaped.
+ @returns The string with the special characters escaped. */
+string
+EscapeForJson(const string & text);
+
+/*! @brief Return a string with the characters that separate the fields and records of a scan
+ recording escaped.
+ @param text The string to be escaped.
+ @returns The string with the special characters escaped. */
+string
+EscapeForRecording(const string & text);
+
+/*! @brief Return a string from a scan recording with its escaped characters restored.
+ @param text The string to be restored.
+ @returns The string with the escaped characters restored. */
+string
+UnescapeFromRecording(const string & text);
+
 #endif // ! defined(__ServiceViewer__Utilities__)
@@ -0,0 +1,282 @@
+//--------------------------------------------------------------------------------------------------
+//
+//  File:       YarpScanSource.cpp
+//
+//  Project:    M+M
+//
+//  Contains:   The class definition for scanning a live YARP network.
+//
+//  Written by: Norman Jaffe
+//
+//  Copyright:  (c) 2026 by H Plus Technologies Ltd. and Simon Fraser University.
+//
+//              All rights reserved. Redistribution and use in source and binary forms, with or
+//              without modification, are permitted provided that the following conditions are met:
+//                * Redistributions of source code must retain the above copyright notice, this list
+//                  of conditions and the following disclaimer.
+//                * Redistributions in binary form must reproduce the above copyright notice, this
+//                  list of conditions and the following disclaimer in the documentation and/or
+//                  other materials provided with the distribution.
+//                * Neither the name of the copyright holders nor the names of its contributors may
+//                  be used to endorse or promote products derived from this software without
+//                  specific prior written permission.
+//
+//              THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+//              EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+//              OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+//              SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+//              INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+//              TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+//              BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+//              CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//              ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+//              DAMAGE.
+//
+//  Created:    2026-10-16
+//
+//--------------------------------------------------------------------------------------------------
+
+#include "YarpScanSource.h"
+
+//#include <odlEnable.h>
+#include <odlInclude.h>
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wc++11-extensions"
+# pragma clang diagnostic ignored "-Wdocumentation"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+# pragma clang diagnostic ignored "-Wpadded"
+# pragma clang diagnostic ignored "-Wshadow"
+# pragma clang diagnostic ignored "-Wunused-parameter"
+# pragma clang diagnostic ignored "-Wweak-vtables"
+#endif // defined(__APPLE__)
+#include <yarp/os/impl/Logger.h>
+#include <yarp/os/Network.h>
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma clang diagnostic push
+# pragma clang diagnostic ignored "-Wunknown-pragmas"
+# pragma clang diagnostic ignored "-Wdocumentation-unknown-command"
+#endif // defined(__APPLE__)
+/*! @file
+ 
+ @brief The class definition for scanning a live YARP network. */
+#if defined(__APPLE__)
+# pragma clang diagnostic pop
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Private structures, constants and variables
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Local functions
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Class methods
+#endif // defined(__APPLE__)
+
+#if defined(__APPLE__)
+# pragma mark Constructors and Destructors
+#endif // defined(__APPLE__)
+
+YarpScanSource::YarpScanSource(void) :
+    inherited()
+{
+    ODL_ENTER(); //####
+    ODL_EXIT_P(this); //####
+} // YarpScanSource::YarpScanSource
+
+YarpScanSource::~YarpScanSource(void)
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT(); //####
+} // YarpScanSource::~YarpScanSource
+
+#if defined(__APPLE__)
+# pragma mark Actions and Accessors
+#endif // defined(__APPLE__)
+
+bool
+YarpScanSource::addConnection(const yarp::os::ConstString & sourceName,
+                              const yarp::os::ConstString & destinationName,
+                              const bool                    isUDP)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    ODL_B1("isUDP = ", isUDP); //####
+    bool result = MplusM::Utilities::AddConnection(sourceName, destinationName,
+                                                   STANDARD_WAIT_TIME, isUDP);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // YarpScanSource::addConnection
+
+bool
+YarpScanSource::checkForRegistryService(const MplusM::Utilities::PortVector & detectedPorts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    bool result = MplusM::Utilities::CheckForRegistryService(detectedPorts);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // YarpScanSource::checkForRegistryService
+
+void
+YarpScanSource::gatherPortConnections(const yarp::os::ConstString &   portName,
+                                      MplusM::Common::ChannelVector & outputs,
+                                      MplusM::Common::CheckFunction   checker,
+                                      void *                          checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("outputs = ", &outputs, "checkStuff = ", checkStuff); //####
+    MplusM::Common::ChannelVector inputs;
+    
+    MplusM::Utilities::GatherPortConnections(portName, inputs, outputs,
+                                             MplusM::Utilities::kInputAndOutputOutput, true,
+                                             checker, checkStuff);
+    ODL_OBJEXIT(); //####
+} // YarpScanSource::gatherPortConnections
+
+bool
+YarpScanSource::getAssociatedPorts(const yarp::os::ConstString &        portName,
+                                   MplusM::Utilities::PortAssociation & associates,
+                                   MplusM::Common::CheckFunction        checker,
+                                   void *                               checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P2("associates = ", &associates, "checkStuff = ", checkStuff); //####
+    bool result = MplusM::Utilities::GetAssociatedPorts(portName, associates, STANDARD_WAIT_TIME,
+                                                        checker, checkStuff);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // YarpScanSource::getAssociatedPorts
+
+void
+YarpScanSource::getDetectedPortList(MplusM::Utilities::PortVector & detectedPorts)
+{
+    ODL_OBJENTER(); //####
+    ODL_P1("detectedPorts = ", &detectedPorts); //####
+    MplusM::Utilities::GetDetectedPortList(detectedPorts);
+    ODL_OBJEXIT(); //####
+} // YarpScanSource::getDetectedPortList
+
+bool
+YarpScanSource::getNameAndDescriptionForService(const yarp::os::ConstString &          serviceName,
+                                                MplusM::Utilities::ServiceDescriptor & descriptor,
+                                                MplusM::Common::CheckFunction          checker,
+                                                void *                                 checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_S1s("serviceName = ", serviceName); //####
+    ODL_P2("descriptor = ", &descriptor, "checkStuff = ", checkStuff); //####
+    bool result = MplusM::Utilities::GetNameAndDescriptionForService(serviceName, descriptor,
+                                                                     STANDARD_WAIT_TIME, checker,
+                                                                     checkStuff);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // YarpScanSource::getNameAndDescriptionForService
+
+bool
+YarpScanSource::getServiceNames(MplusM::Common::StringVector & services,
+                                MplusM::Common::CheckFunction  checker,
+                                void *                         checkStuff)
+{
+    ODL_OBJENTER(); //####
+    ODL_P2("services = ", &services, "checkStuff = ", checkStuff); //####
+    bool result = MplusM::Utilities::GetServiceNames(services, true, checker, checkStuff);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // YarpScanSource::getServiceNames
+
+bool
+YarpScanSource::lookupDirection(const yarp::os::ConstString & portName,
+                                PortEntry::PortDirection &    direction)
+{
+#if MAC_OR_LINUX_
+# pragma unused(portName,direction)
+#endif // MAC_OR_LINUX_
+    ODL_OBJENTER(); //####
+    ODL_S1s("portName = ", portName); //####
+    ODL_P1("direction = ", &direction); //####
+    // The direction of a live port can only be found by testing it.
+    ODL_OBJEXIT_B(false); //####
+    return false;
+} // YarpScanSource::lookupDirection
+
+bool
+YarpScanSource::removeConnection(const yarp::os::ConstString & sourceName,
+                                 const yarp::os::ConstString & destinationName)
+{
+    ODL_OBJENTER(); //####
+    ODL_S2s("sourceName = ", sourceName, "destinationName = ", destinationName); //####
+    bool result = MplusM::Utilities::RemoveConnection(sourceName, destinationName);
+    
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // YarpScanSource::removeConnection
+
+void
+YarpScanSource::removeStalePorts(void)
+{
+    ODL_OBJENTER(); //####
+    MplusM::Utilities::RemoveStalePorts();
+    ODL_OBJEXIT(); //####
+} // YarpScanSource::removeStalePorts
+
+bool
+YarpScanSource::requiresDirectionProbing(void)
+const
+{
+    ODL_OBJENTER(); //####
+    ODL_OBJEXIT_B(true); //####
+    return true;
+} // YarpScanSource::requiresDirectionProbing
+
+bool
+YarpScanSource::start(void)
+{
+    ODL_OBJENTER(); //####
+    bool result = true;
+    
+    MplusM::Utilities::SetUpGlobalStatusReporter();
+    MplusM::Utilities::CheckForNameServerReporter();
+#if CheckNetworkWorks_
+    if (! yarp::os::Network::checkNetwork(NETWORK_CHECK_TIMEOUT))
+    {
+        ODL_LOG("(! yarp::os::Network::checkNetwork(NETWORK_CHECK_TIMEOUT))"); //####
+# if MAC_OR_LINUX_
+        yarp::os::impl::Logger & theLogger = MplusM::Common::GetLogger();
+        
+        theLogger.fail("YARP network not running.");
+# endif // MAC_OR_LINUX_
+        result = false;
+    }
+#endif // CheckNetworkWorks_
+    ODL_OBJEXIT_B(result); //####
+    return result;
+} // YarpScanSource::start
+
+void
+YarpScanSource::stop(void)
+{
+    ODL_OBJENTER(); //####
+    MplusM::Utilities::ShutDownGlobalStatusReporter();
+    ODL_OBJEXIT(); //####
+} // YarpScanSource::stop
+
+#if defined(__APPLE__)
+# pragma mark Global functions
+#endif // defined(__APPLE__)